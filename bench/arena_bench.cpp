@@ -0,0 +1,87 @@
+//
+// arena_bench.cpp
+//
+// Request-scoped allocation throughput: make_unique (global new/delete) vs make_unique_in (monotonic_arena).
+// Each simulated request creates a batch of small objects, then destroys all of them.
+//
+// usage: arena_bench [requests] [objects per request]    (default 10000 1000)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/monotonic_arena.hpp>
+#include <cstdlib>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    struct node
+    {
+        node(int key, int value) :
+            key(key), value(value), next()
+        {
+        }
+
+        int key;
+        int value;
+        node* next;
+    };
+
+    typedef boost::unique_ptr<node> heap_ptr;
+    typedef boost::unique_ptr<node, boost::arena_delete<node> > arena_ptr;
+
+    double run_heap(std::size_t requests, std::size_t objects)
+    {
+        std::vector<heap_ptr> owners(objects);
+        bench::timer t;
+        for(std::size_t r = 0; r < requests; ++r)
+        {
+            for(std::size_t i = 0; i < objects; ++i)
+            {
+                owners[i] = boost::make_unique<node>(static_cast<int>(i), static_cast<int>(r));
+            }
+            bench::do_not_optimize(owners[objects / 2]->value);
+            for(std::size_t i = 0; i < objects; ++i)
+            {
+                owners[i].reset();
+            }
+        }
+        return t.elapsed_ms();
+    }
+
+    double run_arena(std::size_t requests, std::size_t objects)
+    {
+        std::vector<arena_ptr> owners(objects);
+        boost::monotonic_arena arena;
+        bench::timer t;
+        for(std::size_t r = 0; r < requests; ++r)
+        {
+            for(std::size_t i = 0; i < objects; ++i)
+            {
+                owners[i] = boost::make_unique_in<node>(arena, static_cast<int>(i), static_cast<int>(r));
+            }
+            bench::do_not_optimize(owners[objects / 2]->value);
+            for(std::size_t i = 0; i < objects; ++i)
+            {
+                owners[i].reset();
+            }
+            arena.reset();
+        }
+        return t.elapsed_ms();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t requests = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000;
+    const std::size_t objects = argc > 2 ? std::strtoul(argv[2], 0, 10) : 1000;
+    const double total = static_cast<double>(requests) * objects;
+    bench::report_rate("make_unique / default_delete", run_heap(requests, objects), total);
+    bench::report_rate("make_unique_in / arena_delete", run_arena(requests, objects), total);
+    return 0;
+}
@@ -0,0 +1,71 @@
+//
+// array_init_bench.cpp
+//
+// Time-to-first-use of large arrays created with make_unique (value-initialized),
+// make_unique_for_overwrite (default-initialized) and make_unique_zeroed (calloc).
+//
+// usage: array_init_bench [megabytes]    (default 1024)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/make_unique.hpp>
+#include <cstdlib>
+#include "bench_timer.hpp"
+
+namespace
+{
+    const std::size_t page_size = 4096;
+
+    // first use touches one byte every page, like a sparse scratch buffer
+    template<typename Ptr>
+    void first_use(Ptr& ptr, std::size_t n)
+    {
+        for(std::size_t i = 0; i < n; i += page_size)
+        {
+            ptr[i] = 1;
+        }
+        bench::do_not_optimize(ptr[n / 2]);
+    }
+
+    template<typename Ptr>
+    void run(const char* name, Ptr (*make)(std::size_t), std::size_t n)
+    {
+        bench::timer t;
+        Ptr ptr = make(n);
+        const double alloc_ms = t.elapsed_ms();
+        first_use(ptr, n);
+        const double use_ms = t.elapsed_ms();
+        std::printf("%-34s alloc %10.3f ms   alloc + first use %10.3f ms\n", name, alloc_ms, use_ms);
+    }
+
+    boost::unique_ptr<char[]> value_init(std::size_t n)
+    {
+        return boost::make_unique<char[]>(n);
+    }
+
+    boost::unique_ptr<char[]> default_init(std::size_t n)
+    {
+        return boost::make_unique_for_overwrite<char[]>(n);
+    }
+
+    boost::unique_ptr<char[], boost::free_delete<char[]> > zeroed(std::size_t n)
+    {
+        return boost::make_unique_zeroed<char[]>(n);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t mb = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1024;
+    const std::size_t n = mb * 1024 * 1024;
+    std::printf("array of %lu MB\n", static_cast<unsigned long>(mb));
+    run("make_unique<char[]>", &value_init, n);
+    run("make_unique_for_overwrite<char[]>", &default_init, n);
+    run("make_unique_zeroed<char[]>", &zeroed, n);
+    return 0;
+}
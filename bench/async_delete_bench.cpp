@@ -0,0 +1,106 @@
+//
+// async_delete_bench.cpp
+//
+// Time a serving thread spends dropping large tries: default_delete destroys the trie on the spot,
+// async_delete hands it to the reclaimer thread. Also reports the time until the reclaimer caught up
+// and its counters. On a machine with a single core the reclaimer competes with the serving thread.
+//
+// usage: async_delete_bench [tries] [keys per trie]    (default 50 100000)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/async_delete.hpp>
+#include <cstdlib>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    // binary trie over the bits of the keys
+    struct trie
+    {
+        boost::unique_ptr<trie> child[2];
+        std::size_t value;
+
+        trie(void) :
+            value()
+        {
+        }
+
+        void insert(std::size_t key)
+        {
+            trie* n = this;
+            for(std::size_t bit = 0; bit < 20; ++bit)
+            {
+                boost::unique_ptr<trie>& next = n->child[(key >> bit) & 1];
+                if(!next)
+                {
+                    next.reset(new trie);
+                }
+                n = next.get();
+            }
+            n->value = key;
+        }
+    };
+
+    template<class D>
+    std::vector<boost::unique_ptr<trie, D> > build(std::size_t tries, std::size_t keys)
+    {
+        std::vector<boost::unique_ptr<trie, D> > result;
+        for(std::size_t t = 0; t < tries; ++t)
+        {
+            boost::unique_ptr<trie, D> root(new trie);
+            for(std::size_t k = 0; k < keys; ++k)
+            {
+                root->insert(k * 2654435761u + t);
+            }
+            result.push_back(boost::move(root));
+        }
+        return result;
+    }
+
+    template<class D>
+    double drop_all(std::vector<boost::unique_ptr<trie, D> >& owners, double& worst)
+    {
+        worst = 0;
+        bench::timer total;
+        for(std::size_t i = 0; i < owners.size(); ++i)
+        {
+            bench::timer t;
+            owners[i].reset();
+            const double ms = t.elapsed_ms();
+            worst = ms > worst ? ms : worst;
+        }
+        return total.elapsed_ms();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t tries = argc > 1 ? std::strtoul(argv[1], 0, 10) : 50;
+    const std::size_t keys = argc > 2 ? std::strtoul(argv[2], 0, 10) : 100000;
+    double worst;
+
+    std::vector<boost::unique_ptr<trie> > inline_owners = build<boost::default_delete<trie> >(tries, keys);
+    bench::report("default_delete, serving thread", drop_all(inline_owners, worst));
+    bench::report("  worst single reset", worst);
+
+    std::vector<boost::unique_ptr<trie, boost::async_delete<trie> > > async_owners =
+        build<boost::async_delete<trie> >(tries, keys);
+    bench::timer until_drained;
+    bench::report("async_delete, serving thread", drop_all(async_owners, worst));
+    bench::report("  worst single reset", worst);
+    boost::drain_async_deletes();
+    bench::report("  until reclaimed", until_drained.elapsed_ms());
+
+    const boost::async_delete_stats stats = boost::async_delete_statistics();
+    std::printf("reclaimed %llu, backpressure waits %llu, mean latency %.3f ms, max latency %.3f ms\n",
+        static_cast<unsigned long long>(stats.reclaimed), static_cast<unsigned long long>(stats.backpressure_waits),
+        stats.reclaimed != 0 ? stats.total_latency_ns / 1e6 / stats.reclaimed : 0.0, stats.max_latency_ns / 1e6);
+    return 0;
+}
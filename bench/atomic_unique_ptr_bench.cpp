@@ -0,0 +1,189 @@
+//
+// atomic_unique_ptr_bench.cpp
+//
+// Handing buffers between producer and consumer threads through a few shared slots:
+// atomic_unique_ptr vs a unique_ptr guarded by a std::mutex.
+//
+// Before timing, a stress run mixes exchange, take and compare_exchange on both kinds of slot and
+// checks that every object was deleted exactly once (exits with 1 otherwise).
+//
+// usage: atomic_unique_ptr_bench [operations per thread] [max thread pairs]    (default 1000000 and the number of cores)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/atomic_unique_ptr.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    std::atomic<unsigned char>* deletions = 0;
+
+    struct buffer
+    {
+        explicit buffer(std::size_t id) :
+            id(id)
+        {
+        }
+
+        ~buffer(void)
+        {
+            if(deletions != 0)
+            {
+                deletions[id].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t id;
+        char data[48];
+    };
+
+    typedef boost::unique_ptr<buffer> buffer_ptr;
+
+    // the mutex version of the same interface
+    class locked_slot
+    {
+    public:
+        buffer_ptr exchange(buffer_ptr p)
+        {
+            std::lock_guard<std::mutex> l(lock);
+            owner.swap(p);
+            return p;
+        }
+
+        buffer_ptr take(void)
+        {
+            return exchange(buffer_ptr());
+        }
+
+        bool compare_exchange_strong(buffer*& expected, buffer_ptr& desired)
+        {
+            std::lock_guard<std::mutex> l(lock);
+            if(owner.get() == expected)
+            {
+                owner.swap(desired);
+                return true;
+            }
+            expected = owner.get();
+            return false;
+        }
+
+    private:
+        std::mutex lock;
+        buffer_ptr owner;
+    };
+
+    const std::size_t slot_count = 4;
+
+    template<class Slot>
+    void producer(Slot* slots, std::size_t first_id, std::size_t ops)
+    {
+        for(std::size_t i = 0; i < ops; ++i)
+        {
+            buffer_ptr p(new buffer(first_id + i));
+            Slot& s = slots[i % slot_count];
+            if(i % 4 == 0)
+            {
+                // only fill an empty slot, otherwise p gets deleted here
+                buffer* expected = 0;
+                s.compare_exchange_strong(expected, p);
+            }
+            else
+            {
+                // a buffer nobody took yet is deleted here
+                buffer_ptr old = s.exchange(boost::move(p));
+            }
+        }
+    }
+
+    template<class Slot>
+    void consumer(Slot* slots, std::size_t ops)
+    {
+        std::size_t taken = 0;
+        for(std::size_t i = 0; i < ops; ++i)
+        {
+            buffer_ptr p = slots[i % slot_count].take();
+            taken += p ? 1 : 0;
+        }
+        bench::do_not_optimize(taken);
+    }
+
+    template<class Slot>
+    double run(std::size_t pairs, std::size_t ops)
+    {
+        std::vector<Slot> slots(slot_count);
+        std::vector<std::thread> threads;
+        bench::timer t;
+        for(std::size_t p = 0; p < pairs; ++p)
+        {
+            threads.push_back(std::thread(producer<Slot>, &slots[0], p * ops, ops));
+            threads.push_back(std::thread(consumer<Slot>, &slots[0], ops));
+        }
+        for(std::size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+        return t.elapsed_ms();
+    }
+
+    template<class Slot>
+    bool stress(const char* name, std::size_t pairs, std::size_t ops)
+    {
+        const std::size_t total = pairs * ops;
+        std::unique_ptr<std::atomic<unsigned char>[]> counts(new std::atomic<unsigned char>[total]);
+        for(std::size_t i = 0; i < total; ++i)
+        {
+            counts[i].store(0);
+        }
+        deletions = counts.get();
+        run<Slot>(pairs, ops);
+        deletions = 0;
+        for(std::size_t i = 0; i < total; ++i)
+        {
+            if(counts[i].load() != 1)
+            {
+                std::printf("%s: buffer %zu deleted %d times\n", name, i, static_cast<int>(counts[i].load()));
+                return false;
+            }
+        }
+        std::printf("%s: %zu buffers each deleted exactly once\n", name, total);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t ops = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    const std::size_t cores = std::thread::hardware_concurrency();
+    const std::size_t max_pairs = argc > 2 ? std::strtoul(argv[2], 0, 10) : (cores != 0 ? cores : 1);
+
+    if(!boost::atomic_unique_ptr<buffer>().is_lock_free())
+    {
+        std::printf("note: atomic_unique_ptr<buffer> isn't lock-free on this platform\n");
+    }
+    if(!stress<boost::atomic_unique_ptr<buffer> >("atomic_unique_ptr", 8, 100000) || !stress<locked_slot>("mutex", 8, 100000))
+    {
+        return 1;
+    }
+
+    for(std::size_t pairs = 1; pairs <= max_pairs; pairs *= 2)
+    {
+        char name[64];
+        const double total = 2.0 * pairs * ops;
+        std::snprintf(name, sizeof(name), "atomic_unique_ptr, %zu pairs", pairs);
+        bench::report_rate(name, run<boost::atomic_unique_ptr<buffer> >(pairs, ops), total);
+        std::snprintf(name, sizeof(name), "mutex, %zu pairs", pairs);
+        bench::report_rate(name, run<locked_slot>(pairs, ops), total);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+//
+// bench_timer.hpp
+//
+// Helpers shared by the benchmark programs in this directory.
+// Benchmarks need C++11 (<chrono>, <thread>) but exercise the C++03 emulation,
+// build with e.g. g++ -std=c++11 -O2 -I../unique_ptr -pthread foo_bench.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BENCH_TIMER_HPP_
+#define BENCH_TIMER_HPP_
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench
+{
+    class timer
+    {
+    public:
+        timer(void) :
+            start(std::chrono::steady_clock::now())
+        {
+        }
+
+        double elapsed_ms(void) const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        void restart(void)
+        {
+            start = std::chrono::steady_clock::now();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * Keeps the optimizer from discarding a computed value.
+     */
+    template<typename T>
+    inline void do_not_optimize(const T& val)
+    {
+        asm volatile("" : : "g"(&val) : "memory");
+    }
+
+    inline void report(const char* name, double ms)
+    {
+        std::printf("%-40s %12.3f ms\n", name, ms);
+    }
+
+    inline void report_rate(const char* name, double ms, double ops)
+    {
+        std::printf("%-40s %12.3f ms %14.0f ops/s\n", name, ms, ops / (ms / 1000.0));
+    }
+}
+
+#endif // BENCH_TIMER_HPP_
@@ -0,0 +1,254 @@
+//
+// channel_bench.cpp
+//
+// Messages per second moving unique_ptr<message> from producers to consumers at 1, 4, 16 and 64 threads
+// (half producers, half consumers; a single thread pushes a batch and pops it back):
+//
+//  spsc        one spsc_channel per producer/consumer pair
+//  mpmc        one shared mpmc_channel, one message per push/pop
+//  mpmc batch  the same channel using push_n/pop_n with batches of 16
+//  mutex       a std::deque of unique_ptr behind a std::mutex, one message per push/pop
+//
+// Threads yield when the channel is full or empty, so oversubscribed runs still make progress.
+// Every run checks that each message arrived exactly once (exits with 1 otherwise).
+//
+// usage: channel_bench [messages per producer] [capacity]    (default 200000 and 1024)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/channel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    std::atomic<long> alive(0);
+
+    struct message
+    {
+        explicit message(std::size_t id) :
+            id(id)
+        {
+            alive.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ~message(void)
+        {
+            alive.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        std::size_t id;
+        char payload[56];
+    };
+
+    typedef boost::unique_ptr<message> message_ptr;
+
+    const std::size_t batch_size = 16;
+
+    class locked_queue
+    {
+    public:
+        explicit locked_queue(std::size_t capacity) :
+            capacity(capacity)
+        {
+        }
+
+        bool push(message_ptr&& p)
+        {
+            return push_n(&p, 1) == 1;
+        }
+
+        bool pop(message_ptr& p)
+        {
+            return pop_n(&p, 1) == 1;
+        }
+
+        std::size_t push_n(message_ptr* first, std::size_t n)
+        {
+            std::lock_guard<std::mutex> l(lock);
+            const std::size_t m = std::min(n, capacity - queue.size());
+            for(std::size_t i = 0; i < m; ++i)
+            {
+                queue.push_back(std::move(first[i]));
+            }
+            return m;
+        }
+
+        std::size_t pop_n(message_ptr* first, std::size_t n)
+        {
+            std::lock_guard<std::mutex> l(lock);
+            const std::size_t m = std::min(n, queue.size());
+            for(std::size_t i = 0; i < m; ++i)
+            {
+                first[i] = std::move(queue.front());
+                queue.pop_front();
+            }
+            return m;
+        }
+
+    private:
+        const std::size_t capacity;
+        std::mutex lock;
+        std::deque<message_ptr> queue;
+    };
+
+    // push one message, or a batch of them
+    template<class Channel>
+    void send(Channel& ch, std::size_t first_id, std::size_t count, bool batched)
+    {
+        message_ptr batch[batch_size];
+        for(std::size_t id = first_id; id != first_id + count;)
+        {
+            const std::size_t n = batched ? std::min(batch_size, first_id + count - id) : 1;
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                batch[i].reset(new message(id + i));
+            }
+            std::size_t sent = 0;
+            while(sent != n)
+            {
+                const std::size_t moved = n == 1 ? (ch.push(boost::move(batch[0])) ? 1 : 0) : ch.push_n(batch + sent, n - sent);
+                sent += moved;
+                if(moved == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            id += n;
+        }
+    }
+
+    // pop until remaining reaches 0, checking ids off in seen
+    template<class Channel>
+    void receive(Channel& ch, std::atomic<long>& remaining, std::atomic<unsigned char>* seen, bool batched)
+    {
+        message_ptr batch[batch_size];
+        while(remaining.load(std::memory_order_relaxed) > 0)
+        {
+            const std::size_t n = batched ? ch.pop_n(batch, batch_size) : (ch.pop(batch[0]) ? 1 : 0);
+            if(n == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                seen[batch[i]->id].fetch_add(1, std::memory_order_relaxed);
+                batch[i].reset();
+            }
+            remaining.fetch_sub(static_cast<long>(n), std::memory_order_relaxed);
+        }
+    }
+
+    // single thread: fill the channel and drain it again
+    template<class Channel>
+    void ping_pong(Channel& ch, std::size_t count, std::atomic<unsigned char>* seen, bool batched)
+    {
+        std::atomic<long> remaining(0);
+        for(std::size_t id = 0; id < count; id += batch_size)
+        {
+            const std::size_t n = std::min(batch_size, count - id);
+            send(ch, id, n, batched);
+            remaining += static_cast<long>(n);
+            receive(ch, remaining, seen, batched);
+        }
+    }
+
+    bool check(const char* name, std::atomic<unsigned char>* seen, std::size_t total)
+    {
+        for(std::size_t i = 0; i < total; ++i)
+        {
+            if(seen[i].load() != 1)
+            {
+                std::printf("%s: message %zu received %d times\n", name, i, static_cast<int>(seen[i].load()));
+                return false;
+            }
+        }
+        if(alive.load() != 0)
+        {
+            std::printf("%s: %ld messages leaked\n", name, alive.load());
+            return false;
+        }
+        return true;
+    }
+
+    // one channel per producer/consumer pair, or one shared by everyone
+    template<class Channel>
+    bool run(const char* name, std::size_t threads, std::size_t per_producer, std::size_t capacity, bool shared, bool batched)
+    {
+        const std::size_t producers = threads > 1 ? threads / 2 : 1;
+        const std::size_t total = producers * per_producer;
+        std::vector<std::atomic<unsigned char> > seen(total);
+        std::vector<std::unique_ptr<Channel> > channels;
+        for(std::size_t c = 0; c < (shared ? 1 : producers); ++c)
+        {
+            channels.emplace_back(new Channel(capacity));
+        }
+
+        bench::timer t;
+        if(threads == 1)
+        {
+            ping_pong(*channels[0], per_producer, &seen[0], batched);
+        }
+        else
+        {
+            std::vector<std::atomic<long> > remaining(channels.size());
+            for(std::size_t c = 0; c < channels.size(); ++c)
+            {
+                remaining[c] = static_cast<long>(shared ? total : per_producer);
+            }
+            std::vector<std::thread> pool;
+            for(std::size_t p = 0; p < producers; ++p)
+            {
+                Channel& ch = *channels[shared ? 0 : p];
+                std::atomic<long>& left = remaining[shared ? 0 : p];
+                pool.emplace_back([&ch, p, per_producer, batched] { send(ch, p * per_producer, per_producer, batched); });
+                pool.emplace_back([&ch, &left, &seen, batched] { receive(ch, left, &seen[0], batched); });
+            }
+            for(std::size_t i = 0; i < pool.size(); ++i)
+            {
+                pool[i].join();
+            }
+        }
+        const double ms = t.elapsed_ms();
+
+        char label[64];
+        std::snprintf(label, sizeof(label), "%s, %zu threads", name, threads);
+        bench::report_rate(label, ms, static_cast<double>(total));
+        channels.clear();
+        return check(label, &seen[0], total);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t per_producer = argc > 1 ? std::strtoul(argv[1], 0, 10) : 200000;
+    const std::size_t capacity = argc > 2 ? std::strtoul(argv[2], 0, 10) : 1024;
+    const std::size_t thread_counts[] = { 1, 4, 16, 64 };
+
+    for(std::size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i)
+    {
+        const std::size_t threads = thread_counts[i];
+        if(!run<boost::spsc_channel<message_ptr> >("spsc", threads, per_producer, capacity, false, false)
+            || !run<boost::mpmc_channel<message_ptr> >("mpmc", threads, per_producer, capacity, true, false)
+            || !run<boost::mpmc_channel<message_ptr> >("mpmc batch", threads, per_producer, capacity, true, true)
+            || !run<locked_queue>("mutex", threads, per_producer, capacity, true, false))
+        {
+            return 1;
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+//
+// compact_ptr_bench.cpp
+//
+// Pointer chasing through a binary search tree of owned children: boost::unique_ptr nodes allocated with
+// new vs unique_ptr<node, compact_delete<node, compact_arena<> > > nodes (32-bit offsets) allocated with
+// make_unique_compact. Keys are inserted in random order, then random keys are looked up; the smaller
+// compact nodes keep more of the tree in cache.
+//
+// usage: compact_ptr_bench [lookups] [max nodes]    (default 1000000 and 4194304)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/compact_ptr.hpp>
+#include <cstdlib>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    typedef boost::compact_arena<> arena_type;
+
+    struct heap_node
+    {
+        explicit heap_node(unsigned key) :
+            key(key)
+        {
+        }
+
+        boost::unique_ptr<heap_node> left;
+        boost::unique_ptr<heap_node> right;
+        unsigned key;
+    };
+
+    struct compact_node
+    {
+        explicit compact_node(unsigned key) :
+            key(key)
+        {
+        }
+
+        boost::unique_ptr<compact_node, boost::compact_delete<compact_node, arena_type> > left;
+        boost::unique_ptr<compact_node, boost::compact_delete<compact_node, arena_type> > right;
+        unsigned key;
+    };
+
+    typedef boost::unique_ptr<heap_node> heap_ptr;
+    typedef boost::unique_ptr<compact_node, boost::compact_delete<compact_node, arena_type> > compact_node_ptr;
+
+    const heap_node* raw(const heap_ptr& p)
+    {
+        return p.get();
+    }
+
+    const compact_node* raw(const compact_node_ptr& p)
+    {
+        return p.get().get();
+    }
+
+    struct heap_factory
+    {
+        heap_ptr operator()(unsigned key) const
+        {
+            return heap_ptr(new heap_node(key));
+        }
+    };
+
+    struct compact_factory
+    {
+        compact_node_ptr operator()(unsigned key) const
+        {
+            return boost::make_unique_compact<compact_node>(*arena, key);
+        }
+
+        arena_type* arena;
+    };
+
+    template<class Ptr, class Factory>
+    void insert(Ptr& root, unsigned key, const Factory& make)
+    {
+        Ptr* slot = &root;
+        while(*slot)
+        {
+            slot = key < (*slot)->key ? &(*slot)->left : &(*slot)->right;
+        }
+        *slot = make(key);
+    }
+
+    template<class Ptr>
+    double lookups(const Ptr& root, const std::vector<unsigned>& keys, std::size_t count)
+    {
+        std::size_t found = 0;
+        unsigned long long seed = 12345;
+        bench::timer t;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            const unsigned key = keys[(seed >> 33) % keys.size()];
+            for(const auto* n = raw(root); n != 0; n = key < n->key ? raw(n->left) : raw(n->right))
+            {
+                if(n->key == key)
+                {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        const double ms = t.elapsed_ms();
+        bench::do_not_optimize(found);
+        return ms;
+    }
+
+    template<class Ptr, class Factory>
+    double run(std::size_t nodes, std::size_t count, const Factory& make)
+    {
+        std::vector<unsigned> keys(nodes);
+        unsigned long long seed = 42;
+        for(std::size_t i = 0; i < nodes; ++i)
+        {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            keys[i] = static_cast<unsigned>(seed >> 32);
+        }
+        Ptr root;
+        for(std::size_t i = 0; i < nodes; ++i)
+        {
+            insert(root, keys[i], make);
+        }
+        return lookups(root, keys, count);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    const std::size_t max_nodes = argc > 2 ? std::strtoul(argv[2], 0, 10) : 4194304;
+
+    std::printf("node size: unique_ptr %zu bytes, compact %zu bytes\n", sizeof(heap_node), sizeof(compact_node));
+    for(std::size_t nodes = 1024; nodes <= max_nodes; nodes *= 8)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "unique_ptr, %zu nodes", nodes);
+        bench::report_rate(name, run<heap_ptr>(nodes, count, heap_factory()), static_cast<double>(count));
+
+        arena_type arena(nodes * sizeof(compact_node) * 2);
+        compact_factory make = { &arena };
+        std::snprintf(name, sizeof(name), "compact_ptr, %zu nodes", nodes);
+        bench::report_rate(name, run<compact_node_ptr>(nodes, count, make), static_cast<double>(count));
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+//
+// deferred_delete_bench.cpp
+//
+// Latency of a simulated request which builds an object graph and drops it before responding:
+// default_delete frees the graph inside the request, deferred_delete only queues it and the
+// flush_deferred() between requests (outside the measured section) frees it.
+// Prints a latency histogram per variant, plus total time including the flushes.
+//
+// usage: deferred_delete_bench [requests] [nodes per request]    (default 20000 2000)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/deferred_delete.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    // a tree of nodes with text buffers, like a parsed request
+    template<class D>
+    struct node
+    {
+        typedef boost::unique_ptr<node, typename D::template rebind<node>::other> ptr;
+
+        explicit node(std::size_t id) :
+            id(id)
+        {
+        }
+
+        std::size_t id;
+        ptr left;
+        ptr right;
+        boost::unique_ptr<char[], typename D::template rebind<char[]>::other> text;
+    };
+
+    struct inline_policy
+    {
+        template<class T>
+        struct rebind
+        {
+            typedef boost::default_delete<T> other;
+        };
+
+        static void between_requests(void)
+        {
+        }
+    };
+
+    struct deferred_policy
+    {
+        template<class T>
+        struct rebind
+        {
+            typedef boost::deferred_delete<T> other;
+        };
+
+        static void between_requests(void)
+        {
+            boost::flush_deferred();
+        }
+    };
+
+    template<class D>
+    typename node<D>::ptr build(std::size_t first, std::size_t count)
+    {
+        if(count == 0)
+        {
+            return typename node<D>::ptr();
+        }
+        typename node<D>::ptr n(new node<D>(first));
+        n->text.reset(new char[32 + first % 64]);
+        const std::size_t half = (count - 1) / 2;
+        n->left = build<D>(first + 1, half);
+        n->right = build<D>(first + 1 + half, count - 1 - half);
+        return boost::move(n);
+    }
+
+    template<class D>
+    void run(const char* name, std::size_t requests, std::size_t nodes)
+    {
+        std::vector<double> latency(requests);
+        bench::timer total;
+        for(std::size_t r = 0; r < requests; ++r)
+        {
+            bench::timer t;
+            {
+                typename node<D>::ptr graph = build<D>(r, nodes);
+                bench::do_not_optimize(graph->id);
+            }
+            latency[r] = t.elapsed_ms() * 1000.0;
+            D::between_requests();
+        }
+        const double total_ms = total.elapsed_ms();
+
+        std::sort(latency.begin(), latency.end());
+        const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+        std::printf("%s\n", name);
+        for(std::size_t i = 0; i < sizeof(quantiles) / sizeof(quantiles[0]); ++i)
+        {
+            std::printf("  p%-6g %10.2f us\n", quantiles[i] * 100, latency[static_cast<std::size_t>(quantiles[i] * (requests - 1))]);
+        }
+        std::printf("  max     %10.2f us\n", latency.back());
+        // histogram with power of 2 microsecond buckets
+        double limit = 1;
+        for(std::size_t i = 0; i < requests; )
+        {
+            std::size_t count = 0;
+            for(; i < requests && latency[i] < limit; ++i)
+            {
+                ++count;
+            }
+            if(count != 0)
+            {
+                std::printf("  < %8.0f us %8zu\n", limit, count);
+            }
+            limit *= 2;
+        }
+        bench::report_rate("  total including flushes", total_ms, static_cast<double>(requests));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t requests = argc > 1 ? std::strtoul(argv[1], 0, 10) : 20000;
+    const std::size_t nodes = argc > 2 ? std::strtoul(argv[2], 0, 10) : 2000;
+    if(requests == 0 || nodes == 0)
+    {
+        return 1;
+    }
+
+    run<inline_policy>("default_delete (destroyed in the request)", requests, nodes);
+    run<deferred_policy>("deferred_delete (flushed between requests)", requests, nodes);
+    return 0;
+}
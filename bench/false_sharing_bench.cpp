@@ -0,0 +1,83 @@
+//
+// false_sharing_bench.cpp
+//
+// Per-thread counters packed next to each other (make_unique<counter[]>) vs padded to a cache line
+// each and allocated with make_unique_aligned<padded_counter[]>(n, 64). Each thread increments only
+// its own counter; packed counters share cache lines, so every increment bounces the line between cores.
+// Needs more than one core to show a difference.
+//
+// usage: false_sharing_bench [threads] [increments per thread]    (default 4 50000000)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/aligned_delete.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    struct counter
+    {
+        counter(void) :
+            value(0)
+        {
+        }
+
+        std::atomic<long> value;
+    };
+
+    struct alignas(64) padded_counter
+    {
+        padded_counter(void) :
+            value(0)
+        {
+        }
+
+        std::atomic<long> value;
+    };
+
+    template<typename Counter>
+    double run(Counter* counters, std::size_t threads, long increments)
+    {
+        std::vector<std::thread> workers;
+        bench::timer t;
+        for(std::size_t i = 0; i < threads; ++i)
+        {
+            workers.push_back(std::thread([=]()
+            {
+                for(long n = 0; n < increments; ++n)
+                {
+                    counters[i].value.fetch_add(1, std::memory_order_relaxed);
+                }
+            }));
+        }
+        for(std::size_t i = 0; i < threads; ++i)
+        {
+            workers[i].join();
+        }
+        return t.elapsed_ms();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t threads = argc > 1 ? std::strtoul(argv[1], 0, 10) : 4;
+    const long increments = argc > 2 ? std::strtol(argv[2], 0, 10) : 50000000;
+    const double total = static_cast<double>(threads) * increments;
+
+    boost::unique_ptr<counter[]> packed = boost::make_unique<counter[]>(threads);
+    boost::unique_ptr<padded_counter[], boost::aligned_delete<padded_counter[]> > padded =
+        boost::make_unique_aligned<padded_counter[]>(threads, 64);
+
+    bench::report_rate("packed counters (make_unique)", run(packed.get(), threads, increments), total);
+    bench::report_rate("padded counters (make_unique_aligned)", run(padded.get(), threads, increments), total);
+    return 0;
+}
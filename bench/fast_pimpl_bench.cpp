@@ -0,0 +1,157 @@
+//
+// fast_pimpl_bench.cpp
+//
+// A pimpl'd class with a small implementation (a 3D point with a tag) using unique_ptr<impl> vs
+// fast_pimpl<impl, 32>. unique_ptr allocates one impl per object and every accessor loads the pointer
+// before the data; fast_pimpl stores the impl inside the object, so a vector of objects is one contiguous
+// block. Creation, a pass over all objects through an accessor, and destruction are timed separately.
+//
+// usage: fast_pimpl_bench [objects] [rounds]    (default 1000000 10)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/unique_ptr.hpp>
+#include <boost/fast_pimpl.hpp>
+#include <cstdlib>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    // the header part of both variants
+    class heap_point
+    {
+    public:
+        heap_point(double x, double y, double z, int tag);
+        heap_point(heap_point&& p);
+        ~heap_point(void);
+        double norm2(void) const;
+
+    private:
+        struct impl;
+        boost::unique_ptr<impl> pimpl;
+    };
+
+    class inline_point
+    {
+    public:
+        inline_point(double x, double y, double z, int tag);
+        inline_point(inline_point&& p);
+        ~inline_point(void);
+        double norm2(void) const;
+
+    private:
+        struct impl;
+        boost::fast_pimpl<impl, 32, 8> pimpl;
+    };
+
+    // the .cpp part
+    struct heap_point::impl
+    {
+        double x, y, z;
+        int tag;
+    };
+
+    heap_point::heap_point(double x, double y, double z, int tag) :
+        pimpl(new impl())
+    {
+        pimpl->x = x;
+        pimpl->y = y;
+        pimpl->z = z;
+        pimpl->tag = tag;
+    }
+
+    heap_point::heap_point(heap_point&& p) :
+        pimpl(boost::move(p.pimpl))
+    {
+    }
+
+    heap_point::~heap_point(void)
+    {
+    }
+
+    double heap_point::norm2(void) const
+    {
+        return pimpl->x * pimpl->x + pimpl->y * pimpl->y + pimpl->z * pimpl->z + pimpl->tag;
+    }
+
+    struct inline_point::impl
+    {
+        double x, y, z;
+        int tag;
+    };
+
+    inline_point::inline_point(double x, double y, double z, int tag)
+    {
+        pimpl->x = x;
+        pimpl->y = y;
+        pimpl->z = z;
+        pimpl->tag = tag;
+    }
+
+    inline_point::inline_point(inline_point&& p) :
+        pimpl(boost::move(p.pimpl))
+    {
+    }
+
+    inline_point::~inline_point(void)
+    {
+    }
+
+    double inline_point::norm2(void) const
+    {
+        return pimpl->x * pimpl->x + pimpl->y * pimpl->y + pimpl->z * pimpl->z + pimpl->tag;
+    }
+
+    template<class Point>
+    void run(const char* name, std::size_t count, std::size_t rounds)
+    {
+        double create_ms = 0, call_ms = 0, destroy_ms = 0;
+        double sum = 0;
+        std::vector<Point> v;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            v.reserve(count);
+            bench::timer t;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const double d = static_cast<double>(i);
+                v.emplace_back(d, d + 1, d + 2, static_cast<int>(i & 7));
+            }
+            create_ms += t.elapsed_ms();
+
+            t.restart();
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                sum += v[i].norm2();
+            }
+            call_ms += t.elapsed_ms();
+
+            t.restart();
+            v.clear();
+            destroy_ms += t.elapsed_ms();
+        }
+        bench::do_not_optimize(sum);
+
+        std::printf("%s (%zu bytes per object)\n", name, sizeof(Point));
+        const double ops = static_cast<double>(count * rounds);
+        bench::report_rate("  create", create_ms, ops);
+        bench::report_rate("  access", call_ms, ops);
+        bench::report_rate("  destroy", destroy_ms, ops);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    const std::size_t rounds = argc > 2 ? std::strtoul(argv[2], 0, 10) : 10;
+
+    run<heap_point>("unique_ptr<impl>", count, rounds);
+    run<inline_point>("fast_pimpl<impl, 32>", count, rounds);
+    return 0;
+}
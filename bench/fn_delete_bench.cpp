@@ -0,0 +1,92 @@
+//
+// fn_delete_bench.cpp
+//
+// Owners of C-style handles: unique_ptr<widget, void (*)(widget*)> vs
+// unique_ptr<widget, BOOST_UPTR_FN_DELETE(&widget_destroy)>. Only destruction is timed: owners.clear()
+// destroys every owner, which with the function pointer deleter is an indirect call through the pointer
+// stored in each (two word) owner. With fn_delete the owner is one word and widget_destroy is called directly.
+// fn_delete_codegen.sh checks the generated code for that.
+//
+// usage: fn_delete_bench [handles] [rounds]    (default 1000000 20)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/unique_ptr.hpp>
+#include <boost/fn_delete.hpp>
+#include <cstdlib>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    // a C library style handle
+    struct widget
+    {
+        int id;
+    };
+
+    std::size_t destroyed = 0;
+
+    widget* widget_create(int id)
+    {
+        widget* w = static_cast<widget*>(std::malloc(sizeof(widget)));
+        w->id = id;
+        return w;
+    }
+
+    void widget_destroy(widget* w)
+    {
+        ++destroyed;
+        std::free(w);
+    }
+
+    typedef boost::unique_ptr<widget, void (*)(widget*)> fp_owner;
+    typedef boost::unique_ptr<widget, BOOST_UPTR_FN_DELETE(&widget_destroy)> fn_owner;
+
+    fp_owner make(int id, fp_owner*)
+    {
+        return fp_owner(widget_create(id), &widget_destroy);
+    }
+
+    fn_owner make(int id, fn_owner*)
+    {
+        return fn_owner(widget_create(id));
+    }
+
+    template<class Owner>
+    double run(std::size_t handles, std::size_t rounds)
+    {
+        std::vector<Owner> owners;
+        owners.reserve(handles);
+        double ms = 0;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            for(std::size_t i = 0; i < handles; ++i)
+            {
+                owners.push_back(make(static_cast<int>(i), static_cast<Owner*>(0)));
+            }
+            // only destruction is timed
+            bench::timer t;
+            owners.clear();
+            ms += t.elapsed_ms();
+        }
+        return ms;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t handles = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    const std::size_t rounds = argc > 2 ? std::strtoul(argv[2], 0, 10) : 20;
+
+    std::printf("owner size: function pointer %zu bytes, fn_delete %zu bytes\n", sizeof(fp_owner), sizeof(fn_owner));
+    bench::report_rate("function pointer deleter", run<fp_owner>(handles, rounds), static_cast<double>(handles * rounds));
+    bench::report_rate("fn_delete", run<fn_owner>(handles, rounds), static_cast<double>(handles * rounds));
+    bench::do_not_optimize(destroyed);
+    return 0;
+}
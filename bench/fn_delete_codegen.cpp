@@ -0,0 +1,43 @@
+//
+// fn_delete_codegen.cpp
+//
+// Not a benchmark: compiled to assembly by fn_delete_codegen.sh, which checks that reset_fn calls
+// widget_destroy directly and reset_fp calls through the pointer stored in each owner.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/unique_ptr.hpp>
+#include <boost/fn_delete.hpp>
+#include <cstddef>
+
+struct widget
+{
+    int id;
+};
+
+// defined elsewhere, so the call isn't inlined away
+void widget_destroy(widget* w);
+
+typedef boost::unique_ptr<widget, void (*)(widget*)> fp_owner;
+typedef boost::unique_ptr<widget, BOOST_UPTR_FN_DELETE(&widget_destroy)> fn_owner;
+
+extern "C" void reset_fp(fp_owner* owners, std::size_t n)
+{
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        owners[i].reset();
+    }
+}
+
+extern "C" void reset_fn(fn_owner* owners, std::size_t n)
+{
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        owners[i].reset();
+    }
+}
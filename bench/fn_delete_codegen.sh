@@ -0,0 +1,58 @@
+#!/bin/sh
+#
+# fn_delete_codegen.sh
+#
+# Compiles fn_delete_codegen.cpp with optimization and checks the generated code: resetting
+# unique_ptr<widget, BOOST_UPTR_FN_DELETE(&widget_destroy)> must call widget_destroy directly, while
+# unique_ptr<widget, void (*)(widget*)> does (which shows the check recognizes indirect calls).
+# Understands x86 (call/jmp *) and AArch64 (blr/br) assembly.
+#
+# usage: fn_delete_codegen.sh [compiler [flags...]]    (default c++ -O2)
+#
+# (c) 2013 Andrew Ho
+#
+#  Distributed under the Boost Software License, Version 1.0. (See
+#  accompanying file LICENSE_1_0.txt or copy at
+#  http://www.boost.org/LICENSE_1_0.txt)
+
+dir=$(dirname "$0")
+if [ $# -eq 0 ]; then
+    set -- c++ -O2
+fi
+
+asm=$("$@" -S -o - -I"$dir/../unique_ptr" "$dir/fn_delete_codegen.cpp") || exit 1
+
+# instructions of function $1, from its label to the end of the function
+body()
+{
+    echo "$asm" | awk -v f="$1" '$0 == f ":" || $0 == "_" f ":" { p = 1; next }
+        p && (/\.cfi_endproc/ || /^[ \t]*\.size/) { exit }
+        p'
+}
+
+indirect()
+{
+    body "$1" | grep -E '^[[:space:]]*((call|jmp)[a-z]*[[:space:]]+\*|(blr|br)[[:space:]])'
+}
+
+status=0
+if [ -z "$(body reset_fn)" ] || [ -z "$(body reset_fp)" ]; then
+    echo "fn_delete_codegen: reset_fn or reset_fp not found in the assembly"
+    exit 1
+fi
+if indirect reset_fn; then
+    echo "FAIL: the fn_delete owner calls through a pointer"
+    status=1
+elif body reset_fn | grep -Eq '^[[:space:]]*(call|jmp|bl|b)[a-z]*[[:space:]]+_?_Z14widget_destroyP6widget(@PLT)?$'; then
+    echo "ok: the fn_delete owner calls widget_destroy directly"
+else
+    echo "FAIL: the fn_delete owner doesn't call widget_destroy itself (reset() not inlined?)"
+    status=1
+fi
+if indirect reset_fp > /dev/null; then
+    echo "ok: the function pointer owner calls through the stored pointer"
+else
+    echo "FAIL: no indirect call found for the function pointer owner, the check doesn't recognize this target"
+    status=1
+fi
+exit $status
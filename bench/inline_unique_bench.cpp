@@ -0,0 +1,200 @@
+//
+// inline_unique_bench.cpp
+//
+// A vector of small polymorphic strategies (16 to 48 bytes, plus an occasional large one) owned by
+// unique_ptr<strategy> from make_unique vs inline_unique<strategy>. unique_ptr allocates every strategy
+// separately and each call first loads the pointer, then the object; inline_unique keeps the small
+// strategies inside the vector's elements, so creation and destruction don't touch the allocator and
+// dispatch walks memory sequentially. Creation, dispatch and destruction are timed separately.
+//
+// usage: inline_unique_bench [strategies] [rounds]    (default 1000000 10)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/unique_ptr.hpp>
+#include <boost/make_unique.hpp>
+#include <boost/inline_unique.hpp>
+#include <cstdlib>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    struct strategy
+    {
+        virtual ~strategy(void)
+        {
+        }
+
+        virtual long run(long x) const = 0;
+    };
+
+    struct add_strategy : strategy
+    {
+        long a;
+
+        explicit add_strategy(long a) :
+            a(a)
+        {
+        }
+
+        long run(long x) const
+        {
+            return x + a;
+        }
+    };
+
+    struct affine_strategy : strategy
+    {
+        long a, b, c;
+
+        explicit affine_strategy(long a) :
+            a(a), b(a * 3), c(a ^ 5)
+        {
+        }
+
+        long run(long x) const
+        {
+            return (x * a + b) ^ c;
+        }
+    };
+
+    struct poly_strategy : strategy
+    {
+        long coeff[5];
+
+        explicit poly_strategy(long a)
+        {
+            for(int i = 0; i < 5; ++i)
+            {
+                coeff[i] = a + i;
+            }
+        }
+
+        long run(long x) const
+        {
+            long r = 0;
+            for(int i = 0; i < 5; ++i)
+            {
+                r = r * x + coeff[i];
+            }
+            return r;
+        }
+    };
+
+    // doesn't fit, inline_unique puts it on the heap
+    struct table_strategy : strategy
+    {
+        long table[64];
+
+        explicit table_strategy(long a)
+        {
+            for(int i = 0; i < 64; ++i)
+            {
+                table[i] = a * i;
+            }
+        }
+
+        long run(long x) const
+        {
+            return table[x & 63];
+        }
+    };
+
+    typedef boost::unique_ptr<strategy> heap_owner;
+    typedef boost::inline_unique<strategy> inline_owner;
+
+    void create(std::vector<heap_owner>& v, std::size_t i)
+    {
+        const long a = static_cast<long>(i);
+        switch(i % 16)
+        {
+        case 0:
+            v.push_back(boost::make_unique<table_strategy>(a));
+            break;
+        case 1: case 2: case 3: case 4: case 5:
+            v.push_back(boost::make_unique<add_strategy>(a));
+            break;
+        case 6: case 7: case 8: case 9: case 10:
+            v.push_back(boost::make_unique<affine_strategy>(a));
+            break;
+        default:
+            v.push_back(boost::make_unique<poly_strategy>(a));
+            break;
+        }
+    }
+
+    void create(std::vector<inline_owner>& v, std::size_t i)
+    {
+        const long a = static_cast<long>(i);
+        v.push_back(inline_owner());
+        inline_owner& s = v.back();
+        switch(i % 16)
+        {
+        case 0:
+            s.emplace<table_strategy>(a);
+            break;
+        case 1: case 2: case 3: case 4: case 5:
+            s.emplace<add_strategy>(a);
+            break;
+        case 6: case 7: case 8: case 9: case 10:
+            s.emplace<affine_strategy>(a);
+            break;
+        default:
+            s.emplace<poly_strategy>(a);
+            break;
+        }
+    }
+
+    template<class Owner>
+    void run(const char* name, std::size_t count, std::size_t rounds)
+    {
+        double create_ms = 0, call_ms = 0, destroy_ms = 0;
+        long sum = 0;
+        std::vector<Owner> v;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            // reserved up front so inline_unique's relocation on growth isn't measured
+            v.reserve(count);
+            bench::timer t;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                create(v, i);
+            }
+            create_ms += t.elapsed_ms();
+
+            t.restart();
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                sum += v[i]->run(static_cast<long>(i));
+            }
+            call_ms += t.elapsed_ms();
+
+            t.restart();
+            v.clear();
+            destroy_ms += t.elapsed_ms();
+        }
+        bench::do_not_optimize(sum);
+
+        std::printf("%s (%zu bytes per owner)\n", name, sizeof(Owner));
+        const double ops = static_cast<double>(count * rounds);
+        bench::report_rate("  create", create_ms, ops);
+        bench::report_rate("  dispatch", call_ms, ops);
+        bench::report_rate("  destroy", destroy_ms, ops);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    const std::size_t rounds = argc > 2 ? std::strtoul(argv[2], 0, 10) : 10;
+
+    run<heap_owner>("unique_ptr<strategy>", count, rounds);
+    run<inline_owner>("inline_unique<strategy>", count, rounds);
+    return 0;
+}
@@ -0,0 +1,76 @@
+//
+// mapped_lookup_bench.cpp
+//
+// Random dependent lookups over a large table: make_unique<uint64_t[]> (new[]) vs
+// make_unique_mapped<uint64_t[]> with 4K pages vs transparent huge pages.
+// Each lookup's index depends on the previous value, so TLB misses are on the critical path.
+// Huge pages need transparent huge pages enabled (/sys/kernel/mm/transparent_hugepage/enabled
+// set to madvise or always).
+//
+// usage: mapped_lookup_bench [table MB] [lookups]    (default 4096 20000000)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/mmap_delete.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include "bench_timer.hpp"
+
+namespace
+{
+    void fill(std::uint64_t* table, std::size_t n)
+    {
+        std::uint64_t x = 88172645463325252ull;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            table[i] = x;
+        }
+    }
+
+    double run(const std::uint64_t* table, std::size_t n, std::size_t lookups)
+    {
+        std::uint64_t v = 0;
+        bench::timer t;
+        for(std::size_t i = 0; i < lookups; ++i)
+        {
+            v = table[(v + i) % n];
+        }
+        const double ms = t.elapsed_ms();
+        bench::do_not_optimize(v);
+        return ms;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t mb = argc > 1 ? std::strtoul(argv[1], 0, 10) : 4096;
+    const std::size_t lookups = argc > 2 ? std::strtoul(argv[2], 0, 10) : 20000000;
+    const std::size_t n = mb * 1024 * 1024 / sizeof(std::uint64_t);
+
+    {
+        boost::unique_ptr<std::uint64_t[]> table = boost::make_unique_for_overwrite<std::uint64_t[]>(n);
+        fill(table.get(), n);
+        bench::report_rate("new[]", run(table.get(), n, lookups), static_cast<double>(lookups));
+    }
+    {
+        boost::unique_ptr<std::uint64_t[], boost::mmap_delete<std::uint64_t[]> > table =
+            boost::make_unique_mapped<std::uint64_t[]>(n, boost::map_populate);
+        fill(table.get(), n);
+        bench::report_rate("mapped, 4K pages", run(table.get(), n, lookups), static_cast<double>(lookups));
+    }
+    {
+        boost::unique_ptr<std::uint64_t[], boost::mmap_delete<std::uint64_t[]> > table =
+            boost::make_unique_mapped<std::uint64_t[]>(n, boost::map_huge_pages | boost::map_populate);
+        fill(table.get(), n);
+        bench::report_rate("mapped, huge pages", run(table.get(), n, lookups), static_cast<double>(lookups));
+    }
+    return 0;
+}
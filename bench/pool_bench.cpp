@@ -0,0 +1,154 @@
+//
+// pool_bench.cpp
+//
+// Producer/consumer scaling of make_unique_pooled vs make_unique (plain new/delete).
+// Each producer thread allocates messages and hands ownership to its consumer thread through a
+// single-producer/single-consumer ring; the consumer destroys them, so every free is a cross-thread free.
+//
+// usage: pool_bench [messages per pair] [max pairs]    (default 2000000 and the number of cores / 2)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/pool_delete.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    struct message
+    {
+        explicit message(std::size_t id) :
+            id(id)
+        {
+        }
+
+        std::size_t id;
+        char payload[40];
+    };
+
+    const std::size_t ring_size = 1024;
+
+    // raw pointers travel through the ring, ownership is re-established on the consumer side
+    struct ring
+    {
+        ring(void) :
+            head(0), tail(0)
+        {
+        }
+
+        void push(message* m)
+        {
+            const std::size_t t = tail.load(std::memory_order_relaxed);
+            while(t - head.load(std::memory_order_acquire) == ring_size)
+            {
+                std::this_thread::yield();
+            }
+            slots[t % ring_size] = m;
+            tail.store(t + 1, std::memory_order_release);
+        }
+
+        message* pop(void)
+        {
+            const std::size_t h = head.load(std::memory_order_relaxed);
+            while(tail.load(std::memory_order_acquire) == h)
+            {
+                std::this_thread::yield();
+            }
+            message* m = slots[h % ring_size];
+            head.store(h + 1, std::memory_order_release);
+            return m;
+        }
+
+        alignas(64) std::atomic<std::size_t> head;
+        alignas(64) std::atomic<std::size_t> tail;
+        message* slots[ring_size];
+    };
+
+    struct heap_policy
+    {
+        typedef boost::unique_ptr<message> pointer;
+
+        static pointer make(std::size_t i)
+        {
+            return boost::make_unique<message>(i);
+        }
+
+        static void thread_done(void)
+        {
+        }
+    };
+
+    struct pool_policy
+    {
+        typedef boost::unique_ptr<message, boost::pool_delete<message> > pointer;
+
+        static pointer make(std::size_t i)
+        {
+            return boost::make_unique_pooled<message>(i);
+        }
+
+        static void thread_done(void)
+        {
+            boost::release_pool_thread_cache();
+        }
+    };
+
+    template<typename Policy>
+    double run(std::size_t pairs, std::size_t messages)
+    {
+        std::vector<ring> rings(pairs);
+        std::vector<std::thread> threads;
+        bench::timer t;
+        for(std::size_t p = 0; p < pairs; ++p)
+        {
+            ring& r = rings[p];
+            threads.push_back(std::thread([&r, messages]
+            {
+                for(std::size_t i = 0; i < messages; ++i)
+                {
+                    r.push(Policy::make(i).release());
+                }
+                Policy::thread_done();
+            }));
+            threads.push_back(std::thread([&r, messages]
+            {
+                std::size_t sum = 0;
+                for(std::size_t i = 0; i < messages; ++i)
+                {
+                    typename Policy::pointer m(r.pop());
+                    sum += m->id;
+                }
+                bench::do_not_optimize(sum);
+                Policy::thread_done();
+            }));
+        }
+        for(std::size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+        return t.elapsed_ms();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t messages = argc > 1 ? std::strtoul(argv[1], 0, 10) : 2000000;
+    const std::size_t cores = std::thread::hardware_concurrency();
+    const std::size_t max_pairs = argc > 2 ? std::strtoul(argv[2], 0, 10) : (cores > 1 ? cores / 2 : 1);
+    for(std::size_t pairs = 1; pairs <= max_pairs; pairs *= 2)
+    {
+        std::printf("%lu producer/consumer pairs\n", static_cast<unsigned long>(pairs));
+        const double total = static_cast<double>(pairs) * messages;
+        bench::report_rate("  make_unique / default_delete", run<heap_policy>(pairs, messages), total);
+        bench::report_rate("  make_unique_pooled / pool_delete", run<pool_policy>(pairs, messages), total);
+    }
+    return 0;
+}
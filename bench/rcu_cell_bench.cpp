@@ -0,0 +1,159 @@
+//
+// rcu_cell_bench.cpp
+//
+// Reader scaling of a routing table published through rcu_cell vs a unique_ptr behind a
+// pthread reader-writer lock. Reader threads look up random routes for a fixed time while one
+// writer publishes a new table every millisecond. Readers should scale with cores under rcu_cell;
+// the lock's shared counter makes every read write the same cache line.
+//
+// usage: rcu_cell_bench [milliseconds per run] [max readers]    (default 500 and the number of cores)
+//
+// POSIX only (pthread_rwlock).
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/rcu_cell.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include "bench_timer.hpp"
+
+namespace
+{
+    const std::size_t route_count = 1024;
+
+    struct table
+    {
+        explicit table(std::size_t version)
+        {
+            for(std::size_t i = 0; i < route_count; ++i)
+            {
+                routes[i] = static_cast<unsigned>(i * 31 + version);
+            }
+        }
+
+        unsigned routes[route_count];
+    };
+
+    class rcu_routes
+    {
+    public:
+        rcu_routes(void) :
+            cell(boost::unique_ptr<const table>(new table(0)))
+        {
+        }
+
+        unsigned lookup(std::size_t key) const
+        {
+            return cell.read()->routes[key % route_count];
+        }
+
+        void publish(std::size_t version)
+        {
+            cell.update(boost::unique_ptr<const table>(new table(version)));
+        }
+
+    private:
+        boost::rcu_cell<const table> cell;
+    };
+
+    class rwlock_routes
+    {
+    public:
+        rwlock_routes(void) :
+            current(new table(0))
+        {
+            pthread_rwlock_init(&lock, 0);
+        }
+
+        ~rwlock_routes(void)
+        {
+            pthread_rwlock_destroy(&lock);
+        }
+
+        unsigned lookup(std::size_t key) const
+        {
+            pthread_rwlock_rdlock(&lock);
+            const unsigned route = current->routes[key % route_count];
+            pthread_rwlock_unlock(&lock);
+            return route;
+        }
+
+        void publish(std::size_t version)
+        {
+            boost::unique_ptr<const table> next(new table(version));
+            pthread_rwlock_wrlock(&lock);
+            current.swap(next);
+            pthread_rwlock_unlock(&lock);
+        }
+
+    private:
+        mutable pthread_rwlock_t lock;
+        boost::unique_ptr<const table> current;
+    };
+
+    template<class Routes>
+    double run(std::size_t readers, std::size_t ms)
+    {
+        Routes routes;
+        std::atomic<bool> stop(false);
+        std::atomic<unsigned long long> total(0);
+        std::vector<std::thread> threads;
+        for(std::size_t r = 0; r < readers; ++r)
+        {
+            threads.push_back(std::thread([&routes, &stop, &total, r]
+            {
+                unsigned long long reads = 0;
+                unsigned sum = 0;
+                std::size_t key = r * 7919;
+                while(!stop.load(std::memory_order_relaxed))
+                {
+                    for(int i = 0; i < 64; ++i)
+                    {
+                        key = key * 6364136223846793005ull + 1442695040888963407ull;
+                        sum += routes.lookup(key >> 33);
+                    }
+                    reads += 64;
+                }
+                bench::do_not_optimize(sum);
+                total += reads;
+            }));
+        }
+        bench::timer t;
+        for(std::size_t version = 1; t.elapsed_ms() < ms; ++version)
+        {
+            routes.publish(version);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        stop = true;
+        for(std::size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+        return total.load() / (t.elapsed_ms() / 1000.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t ms = argc > 1 ? std::strtoul(argv[1], 0, 10) : 500;
+    const std::size_t cores = std::thread::hardware_concurrency();
+    const std::size_t max_readers = argc > 2 ? std::strtoul(argv[2], 0, 10) : (cores != 0 ? cores : 1);
+
+    std::printf("%-10s %18s %18s\n", "readers", "rcu_cell reads/s", "rwlock reads/s");
+    for(std::size_t readers = 1; readers <= max_readers; readers *= 2)
+    {
+        const double rcu = run<rcu_routes>(readers, ms);
+        const double rw = run<rwlock_routes>(readers, ms);
+        std::printf("%-10zu %18.0f %18.0f\n", readers, rcu, rw);
+    }
+    return 0;
+}
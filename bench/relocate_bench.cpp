@@ -0,0 +1,75 @@
+//
+// relocate_bench.cpp
+//
+// Buffer reallocation cost for owning pointers: element-wise move construct + destroy (what a growing
+// container does without relocation) vs uninitialized_relocate (one memcpy for trivially relocatable types).
+//
+// usage: relocate_bench [elements] [repetitions]    (default 1000000 20)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/relocate.hpp>
+#include <cstdlib>
+#include <new>
+#include "bench_timer.hpp"
+
+namespace
+{
+    typedef boost::unique_ptr<int> ptr_type;
+
+    ptr_type* allocate(std::size_t n)
+    {
+        return static_cast<ptr_type*>(::operator new(n * sizeof(ptr_type)));
+    }
+
+    void move_elements(ptr_type* first, ptr_type* last, ptr_type* dest)
+    {
+        for(; first != last; ++first, ++dest)
+        {
+            ::new (static_cast<void*>(dest)) ptr_type(boost::move(*first));
+            first->~ptr_type();
+        }
+    }
+
+    // bounces the elements between two buffers, reps times
+    template<typename Relocate>
+    double run(std::size_t n, std::size_t reps, Relocate relocate)
+    {
+        ptr_type* a = allocate(n);
+        ptr_type* b = allocate(n);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            ::new (static_cast<void*>(a + i)) ptr_type(new int(static_cast<int>(i)));
+        }
+        bench::timer t;
+        for(std::size_t r = 0; r < reps; ++r)
+        {
+            relocate(a, a + n, b);
+            std::swap(a, b);
+        }
+        const double ms = t.elapsed_ms();
+        bench::do_not_optimize(*a[n / 2]);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            a[i].~ptr_type();
+        }
+        ::operator delete(a);
+        ::operator delete(b);
+        return ms;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    const std::size_t reps = argc > 2 ? std::strtoul(argv[2], 0, 10) : 20;
+    const double total = static_cast<double>(n) * reps;
+    bench::report_rate("move construct + destroy", run(n, reps, move_elements), total);
+    bench::report_rate("uninitialized_relocate", run(n, reps, boost::uninitialized_relocate<ptr_type>), total);
+    return 0;
+}
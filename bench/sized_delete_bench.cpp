@@ -0,0 +1,113 @@
+//
+// sized_delete_bench.cpp
+//
+// Free path cost: default_delete (delete / delete[]) vs sized_delete (::operator delete(p, size)).
+// Objects are freed in a shuffled order so the allocator can't rely on the most recently freed block.
+// The difference depends on the allocator: tcmalloc and jemalloc skip a size class lookup per free
+// when given the size, glibc malloc mostly ignores it. Link against the allocator under test,
+// e.g. -ltcmalloc, and build with -fsized-deallocation on compilers that don't enable it by default.
+//
+// usage: sized_delete_bench [rounds] [objects per round]    (default 200 100000)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/sized_delete.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    struct node
+    {
+        node(void) :
+            key(), value(), next()
+        {
+        }
+
+        explicit node(int key) :
+            key(key), value(), next()
+        {
+        }
+
+        int key;
+        int value;
+        node* next;
+    };
+
+    const std::size_t array_length = 6;
+
+    template<typename Ptr, typename Make>
+    double run(std::size_t rounds, std::size_t objects, const std::vector<std::size_t>& order, Make make)
+    {
+        std::vector<Ptr> owners(objects);
+        bench::timer t;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            for(std::size_t i = 0; i < objects; ++i)
+            {
+                owners[i] = make(i);
+            }
+            bench::do_not_optimize(owners[objects / 2].get());
+            for(std::size_t i = 0; i < objects; ++i)
+            {
+                owners[order[i]].reset();
+            }
+        }
+        return t.elapsed_ms();
+    }
+
+    boost::unique_ptr<node> make_default(std::size_t i)
+    {
+        return boost::make_unique<node>(static_cast<int>(i));
+    }
+
+    boost::unique_ptr<node, boost::sized_delete<node> > make_sized(std::size_t i)
+    {
+        return boost::make_unique_sized<node>(static_cast<int>(i));
+    }
+
+    boost::unique_ptr<node[]> make_default_array(std::size_t)
+    {
+        return boost::make_unique<node[]>(array_length);
+    }
+
+    boost::unique_ptr<node[], boost::sized_delete<node[]> > make_sized_array(std::size_t)
+    {
+        return boost::make_unique_sized<node[]>(array_length);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t rounds = argc > 1 ? std::strtoul(argv[1], 0, 10) : 200;
+    const std::size_t objects = argc > 2 ? std::strtoul(argv[2], 0, 10) : 100000;
+    const double total = static_cast<double>(rounds) * objects;
+
+    std::vector<std::size_t> order(objects);
+    for(std::size_t i = 0; i < objects; ++i)
+    {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+#if !defined(BOOST_UPTR_HAS_SIZED_DEALLOCATION)
+    std::printf("note: sized deallocation unavailable, sized_delete falls back to unsized ::operator delete\n");
+#endif
+    bench::report_rate("node, default_delete",
+        run<boost::unique_ptr<node> >(rounds, objects, order, make_default), total);
+    bench::report_rate("node, sized_delete",
+        run<boost::unique_ptr<node, boost::sized_delete<node> > >(rounds, objects, order, make_sized), total);
+    bench::report_rate("node[6], default_delete",
+        run<boost::unique_ptr<node[]> >(rounds, objects, order, make_default_array), total);
+    bench::report_rate("node[6], sized_delete",
+        run<boost::unique_ptr<node[], boost::sized_delete<node[]> > >(rounds, objects, order, make_sized_array), total);
+    return 0;
+}
@@ -0,0 +1,138 @@
+//
+// uptr_flat_set_bench.cpp
+//
+// Owning a set of objects and looking them up by address: uptr_flat_set<node> vs the usual pair of a
+// std::unordered_set<node*> index and a std::vector<unique_ptr<node> > holding the owners (each node
+// remembers its position in the vector so erase can swap it with the last owner and pop).
+// The unordered_set allocates a list node per element and a lookup follows bucket -> node -> key;
+// uptr_flat_set keeps the pointers in one flat table and owns them there, so a lookup touches one array
+// and there is no second structure to update. Insert, find (hits and misses) and erase are timed.
+//
+// usage: uptr_flat_set_bench [elements] [rounds]    (default 1000000 5)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/unique_ptr.hpp>
+#include <boost/uptr_flat_set.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    struct node
+    {
+        std::size_t slot;
+        int payload[6];
+    };
+
+    class side_vector_set
+    {
+    public:
+        node* insert(boost::unique_ptr<node>&& p)
+        {
+            node* raw = p.get();
+            raw->slot = owners.size();
+            owners.push_back(boost::move(p));
+            index.insert(raw);
+            return raw;
+        }
+
+        bool contains(const node* p) const
+        {
+            return index.count(const_cast<node*>(p)) != 0;
+        }
+
+        bool erase(const node* p)
+        {
+            if(index.erase(const_cast<node*>(p)) == 0)
+            {
+                return false;
+            }
+            const std::size_t i = p->slot;
+            owners[i] = boost::move(owners.back());
+            owners[i]->slot = i;
+            owners.pop_back();
+            return true;
+        }
+
+        void reserve(std::size_t n)
+        {
+            owners.reserve(n);
+            index.reserve(n);
+        }
+
+    private:
+        std::unordered_set<node*> index;
+        std::vector<boost::unique_ptr<node> > owners;
+    };
+
+    template<class Set>
+    void run(const char* name, std::size_t count, std::size_t rounds)
+    {
+        double insert_ms = 0, hit_ms = 0, miss_ms = 0, erase_ms = 0;
+        std::size_t found = 0;
+        std::mt19937 rng(42);
+        std::vector<node*> keys(count);
+        std::vector<node> strangers(count);
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            Set set;
+            set.reserve(count);
+            bench::timer t;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                keys[i] = set.insert(boost::unique_ptr<node>(new node()));
+            }
+            insert_ms += t.elapsed_ms();
+
+            std::shuffle(keys.begin(), keys.end(), rng);
+            t.restart();
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                found += set.contains(keys[i]);
+            }
+            hit_ms += t.elapsed_ms();
+
+            t.restart();
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                found += set.contains(&strangers[i]);
+            }
+            miss_ms += t.elapsed_ms();
+
+            t.restart();
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                found += set.erase(keys[i]);
+            }
+            erase_ms += t.elapsed_ms();
+        }
+        bench::do_not_optimize(found);
+
+        std::printf("%s\n", name);
+        const double ops = static_cast<double>(count * rounds);
+        bench::report_rate("  insert", insert_ms, ops);
+        bench::report_rate("  find (hit)", hit_ms, ops);
+        bench::report_rate("  find (miss)", miss_ms, ops);
+        bench::report_rate("  erase", erase_ms, ops);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    const std::size_t rounds = argc > 2 ? std::strtoul(argv[2], 0, 10) : 5;
+
+    run<side_vector_set>("unordered_set<node*> + vector<unique_ptr<node> >", count, rounds);
+    run<boost::uptr_flat_set<node> >("uptr_flat_set<node>", count, rounds);
+    return 0;
+}
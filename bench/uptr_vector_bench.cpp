@@ -0,0 +1,115 @@
+//
+// uptr_vector_bench.cpp
+//
+// uptr_vector<node> vs std::vector<node*> with manual deletion: push_back n objects, erase a block of
+// elements from the middle one at a time, then clear.
+//
+// usage: uptr_vector_bench [elements] [erases] [rounds]    (default 100000 1000 50)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/uptr_vector.hpp>
+#include <cstdlib>
+#include <vector>
+#include "bench_timer.hpp"
+
+namespace
+{
+    struct node
+    {
+        explicit node(int key) :
+            key(key), value()
+        {
+        }
+
+        int key;
+        int value;
+    };
+
+    struct timings
+    {
+        double push_back;
+        double erase;
+        double clear;
+    };
+
+    void run_raw(std::size_t n, std::size_t erases, timings& out)
+    {
+        std::vector<node*> vec;
+        bench::timer t;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            vec.push_back(new node(static_cast<int>(i)));
+        }
+        out.push_back += t.elapsed_ms();
+        t.restart();
+        for(std::size_t i = 0; i < erases; ++i)
+        {
+            std::vector<node*>::iterator pos = vec.begin() + vec.size() / 2;
+            delete *pos;
+            vec.erase(pos);
+        }
+        out.erase += t.elapsed_ms();
+        t.restart();
+        for(std::size_t i = 0; i < vec.size(); ++i)
+        {
+            delete vec[i];
+        }
+        vec.clear();
+        out.clear += t.elapsed_ms();
+    }
+
+    void run_uptr(std::size_t n, std::size_t erases, timings& out)
+    {
+        boost::uptr_vector<node> vec;
+        bench::timer t;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            vec.push_back(boost::unique_ptr<node>(new node(static_cast<int>(i))));
+        }
+        out.push_back += t.elapsed_ms();
+        t.restart();
+        for(std::size_t i = 0; i < erases; ++i)
+        {
+            vec.erase(vec.begin() + vec.size() / 2);
+        }
+        out.erase += t.elapsed_ms();
+        t.restart();
+        vec.clear();
+        out.clear += t.elapsed_ms();
+    }
+
+    void report(const char* name, const timings& t, std::size_t rounds, std::size_t n, std::size_t erases)
+    {
+        std::printf("%s\n", name);
+        bench::report_rate("  push_back", t.push_back, static_cast<double>(rounds) * n);
+        bench::report_rate("  erase (middle)", t.erase, static_cast<double>(rounds) * erases);
+        bench::report_rate("  clear", t.clear, static_cast<double>(rounds) * (n - erases));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 100000;
+    std::size_t erases = argc > 2 ? std::strtoul(argv[2], 0, 10) : 1000;
+    const std::size_t rounds = argc > 3 ? std::strtoul(argv[3], 0, 10) : 50;
+    if(erases > n)
+    {
+        erases = n;
+    }
+    timings raw = timings();
+    timings uptr = timings();
+    for(std::size_t r = 0; r < rounds; ++r)
+    {
+        run_raw(n, erases, raw);
+        run_uptr(n, erases, uptr);
+    }
+    report("std::vector<node*> + delete", raw, rounds, n, erases);
+    report("uptr_vector<node>", uptr, rounds, n, erases);
+    return 0;
+}
@@ -0,0 +1,119 @@
+//
+// aligned_delete_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "aligned_delete_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace aligned_delete
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    bclass(void) :
+                        val()
+                    {
+                    }
+
+                    virtual ~bclass()
+                    {}
+                };
+
+                class cclass : public bclass
+                {
+                public:
+                    cclass(int val, double)
+                    {
+                        this->val = val;
+                    }
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // aligned_delete is empty for single objects and one word for arrays
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int, boost::aligned_delete<int> >) == sizeof(int*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[], boost::aligned_delete<int[]> >) == 2 * sizeof(int*));
+                        BOOST_STATIC_ASSERT((boost::aligned_delete<int, 64>::alignment == 64));
+                    }
+                    // single object
+                    {
+                        boost::unique_ptr<int, boost::aligned_delete<int> > ptr1 = boost::make_unique_aligned<int>(64);
+                        boost::unique_ptr<int, boost::aligned_delete<int> > ptr2 = boost::make_unique_aligned<int>(64, 3);
+                        boost::unique_ptr<cclass, boost::aligned_delete<cclass> > ptr3 = boost::make_unique_aligned<cclass>(32, 3, 2.5);
+                        ptr1 = boost::move(ptr2);
+                    }
+                    // aligned_delete<U, B> converts to aligned_delete<T, A> iff U* converts to T* and B >= A
+                    {
+                        boost::unique_ptr<cclass, boost::aligned_delete<cclass> > ptr1 = boost::make_unique_aligned<cclass>(64, 3, 2.5);
+                        boost::unique_ptr<bclass, boost::aligned_delete<bclass> > ptr2(boost::move(ptr1));
+                        boost::unique_ptr<int, boost::aligned_delete<int, 64> > ptr3;
+                        boost::unique_ptr<int, boost::aligned_delete<int> > ptr4(boost::move(ptr3));
+                    }
+                    // arrays, the element count travels with the deleter
+                    {
+                        boost::unique_ptr<bclass[], boost::aligned_delete<bclass[]> > ptr1 = boost::make_unique_aligned<bclass[]>(4, 64);
+                        std::size_t n = ptr1.get_deleter().size();
+                        ptr1[n - 1].val = 1;
+                    }
+                    // compile time alignment, recorded in the deleter type
+                    {
+                        boost::unique_ptr<int, boost::aligned_delete<int, 64> > ptr1 = boost::make_unique_aligned<int, 64>();
+                        boost::unique_ptr<cclass, boost::aligned_delete<cclass, 32> > ptr2 = boost::make_unique_aligned<cclass, 32>(3, 2.5);
+                        boost::unique_ptr<int[], boost::aligned_delete<int[], 64> > ptr3 = boost::make_unique_aligned<int[], 64>(4);
+                        boost::unique_ptr<int, boost::aligned_delete<int> > ptr4(boost::move(ptr1));
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // Align must be a power of 2
+                    {
+                        boost::aligned_delete<int, 48> del;
+                    }
+                    // a weaker alignment guarantee doesn't convert to a stronger one
+                    {
+                        boost::unique_ptr<int, boost::aligned_delete<int> > ptr1;
+                        boost::unique_ptr<int, boost::aligned_delete<int, 64> > ptr2(boost::move(ptr1));
+                    }
+                    // compile time alignment must be a power of 2
+                    {
+                        boost::make_unique_aligned<int, 48>();
+                    }
+                    // aligned_delete<U[]> can't delete an array of a different type
+                    {
+                        const boost::aligned_delete<bclass[]> del(1);
+                        cclass* c = 0;
+                        del(c);
+                    }
+                    // arrays of known bound can't be created
+                    {
+                        boost::make_unique_aligned<int[2]>(64);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
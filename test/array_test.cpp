@@ -47,6 +47,14 @@ namespace boost
                  */
                 void valid_compile_test(void)
                 {
+                    // empty deleters should not take up any space
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[]>) == sizeof(int*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<bclass[]>) == sizeof(bclass*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<std::fstream[], stream_closer>) == sizeof(std::fstream*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[], fake_int<int[]> >) == sizeof(double*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[], const boost::default_delete<int[]> >) == sizeof(int*));
+                    }
                     // 20.7.1.2.1-1 unique_ptr default constructor
                     {
                         const boost::unique_ptr<int[]> uptr1;
@@ -0,0 +1,118 @@
+//
+// async_delete_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "async_delete_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace async_delete
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    virtual ~bclass()
+                    {}
+                };
+
+                class cclass : public bclass
+                {
+                };
+
+                // owns more objects, they are queued from the reclaimer thread
+                class node
+                {
+                public:
+                    boost::unique_ptr<node, boost::async_delete<node> > next;
+                };
+
+                class incomplete;
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // async_delete is stateless
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int, boost::async_delete<int> >) == sizeof(int*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[], boost::async_delete<int[]> >) == sizeof(int*));
+                    }
+                    // single objects and arrays
+                    {
+                        boost::unique_ptr<int, boost::async_delete<int> > ptr1(new int(3));
+                        boost::unique_ptr<int, boost::async_delete<int> > ptr2(boost::move(ptr1));
+                        boost::unique_ptr<int[], boost::async_delete<int[]> > ptr3(new int[3]);
+                        ptr2.reset();
+                        ptr3.reset();
+                    }
+                    // const objects
+                    {
+                        boost::unique_ptr<const cclass, boost::async_delete<const cclass> > ptr1(new cclass);
+                        boost::unique_ptr<const int[], boost::async_delete<const int[]> > ptr2(new int[2]);
+                        boost::unique_ptr<cclass, boost::async_delete<cclass> > ptr3(new cclass);
+                        boost::unique_ptr<const bclass, boost::async_delete<const bclass> > ptr4(boost::move(ptr3));
+                    }
+                    // async_delete<U> and default_delete<U> are convertible iff U* is implicitly convertible to T*
+                    {
+                        boost::unique_ptr<cclass, boost::async_delete<cclass> > ptr1(new cclass);
+                        boost::unique_ptr<bclass, boost::async_delete<bclass> > ptr2(boost::move(ptr1));
+                        boost::unique_ptr<cclass> ptr3(new cclass);
+                        boost::unique_ptr<bclass, boost::async_delete<bclass> > ptr4(boost::move(ptr3));
+                    }
+                    // object graphs
+                    {
+                        boost::unique_ptr<node, boost::async_delete<node> > head(new node);
+                        head->next.reset(new node);
+                    }
+                    // shutdown and counters
+                    {
+                        boost::drain_async_deletes();
+                        boost::async_delete_stats stats = boost::async_delete_statistics();
+                        std::size_t depth = stats.queue_depth;
+                        boost::uint64_t latency = stats.max_latency_ns;
+                        (void)depth;
+                        (void)latency;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // no conversion from base to derived
+                    {
+                        boost::unique_ptr<bclass, boost::async_delete<bclass> > ptr1;
+                        boost::unique_ptr<cclass, boost::async_delete<cclass> > ptr2(boost::move(ptr1));
+                    }
+                    // arrays of U can't be deleted as arrays of T
+                    {
+                        boost::async_delete<bclass[]> del;
+                        del(static_cast<cclass*>(0));
+                    }
+                    // incomplete types can't be deleted
+                    {
+                        boost::async_delete<incomplete> del;
+                        del(static_cast<incomplete*>(0));
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
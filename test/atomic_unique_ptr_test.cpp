@@ -0,0 +1,111 @@
+//
+// atomic_unique_ptr_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "atomic_unique_ptr_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace atomic_unique_ptr
+            {
+                // deleter with state
+                struct counting_delete
+                {
+                    counting_delete(void) :
+                        count()
+                    {
+                    }
+
+                    void operator()(int* ptr) const
+                    {
+                        ++*count;
+                        delete ptr;
+                    }
+
+                    int* count;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // stateless deleters are lock-free
+                    {
+                        BOOST_STATIC_ASSERT(boost::atomic_unique_ptr<int>::is_always_lock_free);
+                        BOOST_STATIC_ASSERT(boost::atomic_unique_ptr<int[]>::is_always_lock_free);
+                        BOOST_STATIC_ASSERT(!(boost::atomic_unique_ptr<int, counting_delete>::is_always_lock_free));
+                    }
+                    // moving ownership in and out
+                    {
+                        boost::atomic_unique_ptr<int> slot;
+                        boost::atomic_unique_ptr<int> slot2(boost::unique_ptr<int>(new int(3)));
+                        slot.store(boost::unique_ptr<int>(new int(1)));
+                        boost::unique_ptr<int> ptr1(new int(2));
+                        boost::unique_ptr<int> ptr2 = slot.exchange(boost::move(ptr1));
+                        boost::unique_ptr<int> ptr3 = slot.take();
+                        bool lock_free = slot.is_lock_free();
+                        (void)lock_free;
+                    }
+                    // compare and swap ownership
+                    {
+                        boost::atomic_unique_ptr<int> slot;
+                        boost::unique_ptr<int> desired(new int(1));
+                        int* expected = 0;
+                        if(!slot.compare_exchange_strong(expected, desired))
+                        {
+                        }
+                        expected = slot.load();
+                        while(!slot.compare_exchange_weak(expected, desired))
+                        {
+                        }
+                    }
+                    // arrays and stateful deleters
+                    {
+                        boost::atomic_unique_ptr<int[]> slot;
+                        slot.store(boost::unique_ptr<int[]>(new int[2]));
+                        boost::atomic_unique_ptr<int, counting_delete> counted;
+                        boost::unique_ptr<int, counting_delete> file = counted.take();
+                        counted.store(boost::move(file));
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // can't be copied
+                    {
+                        boost::atomic_unique_ptr<int> slot1;
+                        boost::atomic_unique_ptr<int> slot2(slot1);
+                    }
+                    // lvalues aren't moved from implicitly
+                    {
+                        boost::atomic_unique_ptr<int> slot;
+                        boost::unique_ptr<int> ptr;
+                        slot.store(ptr);
+                    }
+                    // different deleters don't mix
+                    {
+                        boost::atomic_unique_ptr<int[]> slot;
+                        slot.store(boost::unique_ptr<int>());
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
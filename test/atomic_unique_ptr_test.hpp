@@ -0,0 +1,40 @@
+//
+// atomic_unique_ptr_test.hpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ATOMIC_UNIQUE_PTR_TEST_HPP_
+#define ATOMIC_UNIQUE_PTR_TEST_HPP_
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/atomic_unique_ptr.hpp>
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace atomic_unique_ptr
+            {
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void);
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void);
+#endif
+            }
+        }
+    }
+}
+
+#endif // ATOMIC_UNIQUE_PTR_TEST_HPP_
@@ -36,6 +36,17 @@ namespace boost
                     {}
                 };
 
+#if !defined(BOOST_NO_CXX11_FINAL)
+                // empty, but can't be used as a base class
+                struct final_delete final
+                {
+                    void operator()(int* ptr) const
+                    {
+                        delete ptr;
+                    }
+                };
+#endif
+
                 template<typename T>
                 void function_deleter(T* val)
                 {
@@ -47,6 +58,21 @@ namespace boost
                  */
                 void valid_compile_test(void)
                 {
+                    // empty deleters should not take up any space
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int>) == sizeof(int*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<bclass>) == sizeof(bclass*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<std::fstream, stream_closer>) == sizeof(std::fstream*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int, fake_int<int> >) == sizeof(double*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int, const boost::default_delete<int> >) == sizeof(int*));
+                    }
+#if !defined(BOOST_NO_CXX11_FINAL)
+                    // final empty deleters are stored as a member
+                    {
+                        boost::unique_ptr<int, final_delete> uptr(new int(3));
+                        uptr.reset();
+                    }
+#endif
                     // 20.7.1.2.1-1 unique_ptr default constructor
                     {
                         const boost::unique_ptr<int> uptr1;
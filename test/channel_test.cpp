@@ -0,0 +1,135 @@
+//
+// channel_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "channel_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace channel
+            {
+                // deleter with state
+                struct counting_delete
+                {
+                    counting_delete(void) :
+                        count()
+                    {
+                    }
+
+                    void operator()(int* ptr) const
+                    {
+                        ++*count;
+                        delete ptr;
+                    }
+
+                    int* count;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // single producer, single consumer
+                    {
+                        boost::spsc_channel<boost::unique_ptr<int> > ch(100);
+                        std::size_t capacity = ch.capacity();
+                        bool pushed = ch.push(boost::unique_ptr<int>(new int(1)));
+                        boost::unique_ptr<int> ptr(new int(2));
+                        pushed = ch.push(boost::move(ptr));
+                        boost::unique_ptr<int> out;
+                        bool popped = ch.pop(out);
+                        std::size_t size = ch.size();
+                        bool empty = ch.empty();
+                        (void)capacity;
+                        (void)pushed;
+                        (void)popped;
+                        (void)size;
+                        (void)empty;
+                    }
+                    // any number of producers and consumers
+                    {
+                        boost::mpmc_channel<boost::unique_ptr<int> > ch(100);
+                        std::size_t capacity = ch.capacity();
+                        bool pushed = ch.push(boost::unique_ptr<int>(new int(1)));
+                        boost::unique_ptr<int> out;
+                        bool popped = ch.pop(out);
+                        std::size_t size = ch.size();
+                        (void)capacity;
+                        (void)pushed;
+                        (void)popped;
+                        (void)size;
+                    }
+                    // batches
+                    {
+                        boost::spsc_channel<boost::unique_ptr<int> > spsc(16);
+                        boost::mpmc_channel<boost::unique_ptr<int> > mpmc(16);
+                        boost::unique_ptr<int> batch[4];
+                        std::size_t moved = spsc.push_n(batch, 4);
+                        moved = spsc.pop_n(batch, 4);
+                        moved = mpmc.push_n(batch, 4);
+                        moved = mpmc.pop_n(batch, 4);
+                        (void)moved;
+                    }
+                    // arrays and stateful deleters
+                    {
+                        boost::mpmc_channel<boost::unique_ptr<int[]> > arrays(8);
+                        arrays.push(boost::unique_ptr<int[]>(new int[2]));
+                        int count = 0;
+                        counting_delete d;
+                        d.count = &count;
+                        boost::spsc_channel<boost::unique_ptr<int, counting_delete> > counted(8, d);
+                        const counting_delete& d2 = counted.get_deleter();
+                        counted.push(boost::unique_ptr<int, counting_delete>(new int(1), d));
+                        (void)d2;
+                    }
+                    // only the pointer is stored per object
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::spsc_channel<boost::unique_ptr<int> >)
+                            == sizeof(boost::spsc_channel<boost::unique_ptr<double> >));
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // can't be copied
+                    {
+                        boost::spsc_channel<boost::unique_ptr<int> > ch1(8);
+                        boost::spsc_channel<boost::unique_ptr<int> > ch2(ch1);
+                    }
+                    // lvalues aren't moved from implicitly
+                    {
+                        boost::mpmc_channel<boost::unique_ptr<int> > ch(8);
+                        boost::unique_ptr<int> ptr;
+                        ch.push(ptr);
+                    }
+                    // different deleters don't mix
+                    {
+                        boost::spsc_channel<boost::unique_ptr<int[]> > ch(8);
+                        ch.push(boost::unique_ptr<int>());
+                    }
+                    // only unique_ptr can be sent
+                    {
+                        boost::mpmc_channel<int*> ch(8);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
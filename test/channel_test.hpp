@@ -0,0 +1,40 @@
+//
+// channel_test.hpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef CHANNEL_TEST_HPP_
+#define CHANNEL_TEST_HPP_
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/channel.hpp>
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace channel
+            {
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void);
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void);
+#endif
+            }
+        }
+    }
+}
+
+#endif // CHANNEL_TEST_HPP_
@@ -0,0 +1,114 @@
+//
+// compact_ptr_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "compact_ptr_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace compact_ptr
+            {
+                typedef boost::compact_arena<> arena_type;
+                struct other_tag;
+                typedef boost::compact_arena<4, other_tag> other_arena_type;
+
+                struct node
+                {
+                    node(void) :
+                        key()
+                    {
+                    }
+
+                    node(int key, double) :
+                        key(key)
+                    {
+                    }
+
+                    boost::unique_ptr<node, boost::compact_delete<node, arena_type> > left;
+                    boost::unique_ptr<node, boost::compact_delete<node, arena_type> > right;
+                    int key;
+                };
+
+                typedef boost::unique_ptr<node, boost::compact_delete<node, arena_type> > node_ptr;
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // owning pointers are 32 bits
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::compact_ptr<node, arena_type>) == 4);
+                        BOOST_STATIC_ASSERT(sizeof(node_ptr) == 4);
+                        BOOST_STATIC_ASSERT(sizeof(node) == 12);
+                        BOOST_STATIC_ASSERT(arena_type::granularity == 8);
+                    }
+                    // ownership through the custom pointer type
+                    {
+                        arena_type arena(1024 * 1024);
+                        node_ptr root = boost::make_unique_compact<node>(arena);
+                        root->left = boost::make_unique_compact<node>(arena, 1, 2.5);
+                        (*root).key = root->left->key;
+                        node_ptr ptr(boost::move(root->left));
+                        boost::compact_ptr<node, arena_type> raw = ptr.release();
+                        node* p = raw.get();
+                        ptr.reset(raw);
+                        if(!ptr || ptr == root || ptr.get() == boost::compact_ptr<node, arena_type>(p) || ptr.get().offset() == 0)
+                        {
+                        }
+                        ptr.reset();
+                        std::size_t used = arena.used();
+                        (void)used;
+                        arena.reset();
+                    }
+                    // independent arenas
+                    {
+                        other_arena_type arena(4096);
+                        boost::unique_ptr<int, boost::compact_delete<int, other_arena_type> > ptr =
+                            boost::make_unique_compact<int>(arena, 3);
+                        boost::uint64_t max = other_arena_type::max_capacity();
+                        (void)max;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    arena_type arena(4096);
+                    // arenas can't be copied
+                    {
+                        arena_type arena2(arena);
+                    }
+                    // raw pointers aren't implicitly compact
+                    {
+                        node_ptr ptr(new node());
+                    }
+                    // pointers into different arenas don't mix
+                    {
+                        boost::unique_ptr<int, boost::compact_delete<int, other_arena_type> > ptr =
+                            boost::make_unique_compact<int>(arena, 3);
+                    }
+                    // arrays aren't supported
+                    {
+                        boost::make_unique_compact<int[]>(arena, 2);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+//
+// deferred_delete_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "deferred_delete_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace deferred_delete
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    virtual ~bclass()
+                    {}
+                };
+
+                class cclass : public bclass
+                {
+                };
+
+                // owns more deferred objects, they are destroyed by the same flush
+                class node
+                {
+                public:
+                    boost::unique_ptr<node, boost::deferred_delete<node> > next;
+                };
+
+                class incomplete;
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // deferred_delete is stateless
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int, boost::deferred_delete<int> >) == sizeof(int*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[], boost::deferred_delete<int[]> >) == sizeof(int*));
+                    }
+                    // single objects and arrays
+                    {
+                        boost::unique_ptr<int, boost::deferred_delete<int> > ptr1(new int(3));
+                        boost::unique_ptr<int, boost::deferred_delete<int> > ptr2(boost::move(ptr1));
+                        boost::unique_ptr<int[], boost::deferred_delete<int[]> > ptr3(new int[3]);
+                        ptr2.reset();
+                        ptr3.reset();
+                    }
+                    // const objects
+                    {
+                        boost::unique_ptr<const cclass, boost::deferred_delete<const cclass> > ptr1(new cclass);
+                        boost::unique_ptr<const int[], boost::deferred_delete<const int[]> > ptr2(new int[2]);
+                    }
+                    // deferred_delete<U> and default_delete<U> are convertible iff U* is implicitly convertible to T*
+                    {
+                        boost::unique_ptr<cclass, boost::deferred_delete<cclass> > ptr1(new cclass);
+                        boost::unique_ptr<bclass, boost::deferred_delete<bclass> > ptr2(boost::move(ptr1));
+                        boost::unique_ptr<cclass> ptr3(new cclass);
+                        boost::unique_ptr<bclass, boost::deferred_delete<bclass> > ptr4(boost::move(ptr3));
+                    }
+                    // object graphs
+                    {
+                        boost::unique_ptr<node, boost::deferred_delete<node> > head(new node);
+                        head->next.reset(new node);
+                    }
+                    // flush points
+                    {
+                        std::size_t pending = boost::deferred_pending();
+                        boost::flush_deferred();
+                        (void)pending;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // no conversion from base to derived
+                    {
+                        boost::unique_ptr<bclass, boost::deferred_delete<bclass> > ptr1;
+                        boost::unique_ptr<cclass, boost::deferred_delete<cclass> > ptr2(boost::move(ptr1));
+                    }
+                    // arrays of U can't be deleted as arrays of T
+                    {
+                        boost::deferred_delete<bclass[]> del;
+                        del(static_cast<cclass*>(0));
+                    }
+                    // incomplete types can't be deleted
+                    {
+                        boost::deferred_delete<incomplete> del;
+                        del(static_cast<incomplete*>(0));
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
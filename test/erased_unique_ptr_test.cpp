@@ -0,0 +1,139 @@
+//
+// erased_unique_ptr_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "erased_unique_ptr_test.hpp"
+#include <string>
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace erased_unique_ptr
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    bclass(void) :
+                        val()
+                    {
+                    }
+                };
+
+                // not derived from bclass, no virtual destructor
+                class cclass
+                {
+                public:
+                    cclass(int val, const std::string& name) :
+                        val(val), name(name)
+                    {
+                    }
+
+                    int val;
+                    std::string name;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // a pointer and a destroy function
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::erased_unique_ptr) <= 2 * sizeof(void*));
+                    }
+                    // unrelated types in one container
+                    {
+                        boost::erased_unique_ptr objects[3];
+                        objects[0] = boost::make_erased<bclass>();
+                        objects[1] = boost::make_erased<cclass>(3, std::string("three"));
+                        objects[2] = boost::make_erased<int>(4);
+                        cclass* c = static_cast<cclass*>(objects[1].get());
+                        bool is_c = objects[1].get_deleter().destroys<cclass>();
+                        (void)c;
+                        (void)is_c;
+                    }
+                    // ownership
+                    {
+                        boost::erased_unique_ptr ptr1 = boost::make_erased<bclass>();
+                        boost::erased_unique_ptr ptr2(boost::move(ptr1));
+                        ptr1 = boost::move(ptr2);
+                        ptr1.reset();
+                        boost::erased_unique_ptr ptr3;
+                        swap(ptr1, ptr3);
+                    }
+                    // raw pointers set the destroy function for their type
+                    {
+                        boost::erased_unique_ptr ptr1(new bclass());
+                        ptr1.reset(new cclass(2, std::string("two")));
+                        bool is_c = ptr1.get_deleter().destroys<cclass>();
+                        ptr1 = boost::make_erased<bclass>();
+                        ptr1.reset(new int(5));
+                        ptr1.reset(new const bclass());
+                        (void)is_c;
+                    }
+                    // comparison operators
+                    {
+                        boost::erased_unique_ptr ptr1 = boost::make_erased<int>(1);
+                        boost::erased_unique_ptr ptr2;
+                        boost::unique_ptr<int> ptr3(new int(2));
+                        if(ptr1 == ptr2 || ptr1 != ptr2 || ptr1 < ptr2 || ptr1 <= ptr2 || ptr1 > ptr2 || ptr1 >= ptr2
+                            || ptr1 == ptr3 || ptr3 < ptr1)
+                        {
+                        }
+                    }
+                    // unique_ptr<T> converts, deleting as T
+                    {
+                        boost::unique_ptr<cclass> ptr1(new cclass(1, std::string("one")));
+                        boost::erased_unique_ptr ptr2(boost::move(ptr1));
+                        boost::unique_ptr<bclass> ptr3(new bclass());
+                        ptr2 = boost::move(ptr3);
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // can't be copied
+                    {
+                        boost::erased_unique_ptr ptr1 = boost::make_erased<int>(1);
+                        boost::erased_unique_ptr ptr2(ptr1);
+                    }
+                    // unique_ptr<T[]> can't be erased
+                    {
+                        boost::unique_ptr<int[]> ptr1(new int[2]);
+                        boost::erased_unique_ptr ptr2(boost::move(ptr1));
+                    }
+                    // arrays aren't supported
+                    {
+                        boost::make_erased<int[]>(2);
+                    }
+                    // the type of the object is needed
+                    {
+                        boost::erased_unique_ptr ptr1(static_cast<void*>(new int(1)));
+                        ptr1.reset(static_cast<void*>(new int(2)));
+                    }
+                    // a deleter can't be passed with a raw pointer
+                    {
+                        boost::erased_unique_ptr ptr1(new bclass(), boost::default_delete<bclass>());
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
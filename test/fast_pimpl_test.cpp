@@ -0,0 +1,169 @@
+//
+// fast_pimpl_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "fast_pimpl_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace fast_pimpl
+            {
+                // what would be in the header: impl is incomplete
+                class widget
+                {
+                    BOOST_COPYABLE_AND_MOVABLE(widget)
+
+                public:
+                    widget(void);
+                    widget(int id, double weight);
+                    widget(const widget& w);
+                    widget(BOOST_RV_REF(widget) w);
+                    ~widget(void);
+
+                    widget& operator=(BOOST_COPY_ASSIGN_REF(widget) w);
+                    widget& operator=(BOOST_RV_REF(widget) w);
+
+                    int id(void) const;
+
+                private:
+                    class impl;
+                    boost::fast_pimpl<impl, 16, 8> pimpl;
+                };
+
+                // what would be in the .cpp file
+                class widget::impl
+                {
+                public:
+                    int id;
+                    double weight;
+
+                    impl(void) :
+                        id(), weight()
+                    {
+                    }
+
+                    impl(int id, double weight) :
+                        id(id), weight(weight)
+                    {
+                    }
+                };
+
+                widget::widget(void)
+                {
+                }
+
+                widget::widget(int id, double weight) :
+                    pimpl(id, weight)
+                {
+                }
+
+                widget::widget(const widget& w) :
+                    pimpl(w.pimpl)
+                {
+                }
+
+                widget::widget(BOOST_RV_REF(widget) w) :
+                    pimpl(boost::move(w.pimpl))
+                {
+                }
+
+                widget::~widget(void)
+                {
+                }
+
+                widget& widget::operator=(BOOST_COPY_ASSIGN_REF(widget) w)
+                {
+                    pimpl = w.pimpl;
+                    return *this;
+                }
+
+                widget& widget::operator=(BOOST_RV_REF(widget) w)
+                {
+                    pimpl = boost::move(w.pimpl);
+                    return *this;
+                }
+
+                int widget::id(void) const
+                {
+                    // const propagates to the impl
+                    const impl& i = *pimpl;
+                    return pimpl->id + i.id + pimpl.get()->id;
+                }
+
+                class too_big
+                {
+                    double data[4];
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // no space beyond the reservation
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(widget) == 16);
+                    }
+                    // constructors, copies and moves of the outer class
+                    {
+                        widget w1;
+                        widget w2(3, 0.5);
+                        widget w3(w2);
+                        widget w4(boost::move(w3));
+                        w1 = w2;
+                        w1 = boost::move(w4);
+                        int id = w1.id();
+                        (void)id;
+                    }
+                    // fast_pimpl directly
+                    {
+                        boost::fast_pimpl<int, sizeof(int), sizeof(int)> p1(3);
+                        boost::fast_pimpl<int, sizeof(int), sizeof(int)> p2;
+                        boost::fast_pimpl<int, sizeof(int), sizeof(int)> p3(p1);
+                        *p2 = 5;
+                        p1.swap(p2);
+                        swap(p1, p2);
+                        p3 = boost::move(p1);
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // Size too small for the impl
+                    {
+                        boost::fast_pimpl<too_big, 16> p;
+                    }
+                    // Align too small for the impl
+                    {
+                        boost::fast_pimpl<double, sizeof(double), 1> p;
+                    }
+                    // const propagates
+                    {
+                        const boost::fast_pimpl<int, sizeof(int), sizeof(int)> p;
+                        *p = 3;
+                    }
+                    // the conversion constructors are explicit
+                    {
+                        boost::fast_pimpl<int, sizeof(int), sizeof(int)> p = 3;
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
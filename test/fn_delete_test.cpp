@@ -0,0 +1,97 @@
+//
+// fn_delete_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "fn_delete_test.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <boost/type_traits/is_empty.hpp>
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace fn_delete
+            {
+                struct handle
+                {
+                    int id;
+                };
+
+                void destroy_handle(handle* h)
+                {
+                    delete h;
+                }
+
+                int close_handle(handle* h)
+                {
+                    delete h;
+                    return 0;
+                }
+
+                typedef boost::unique_ptr<std::FILE, BOOST_UPTR_FN_DELETE(&std::fclose)> unique_file;
+                typedef boost::unique_ptr<char, BOOST_UPTR_FN_DELETE(&std::free)> unique_cstr;
+                typedef boost::unique_ptr<handle, BOOST_UPTR_FN_DELETE(&destroy_handle)> unique_handle;
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // the function isn't stored, unlike a function pointer deleter
+                    {
+                        BOOST_STATIC_ASSERT(boost::is_empty<BOOST_UPTR_FN_DELETE(&destroy_handle)>::value);
+                        BOOST_STATIC_ASSERT(sizeof(unique_handle) == sizeof(handle*));
+                        BOOST_STATIC_ASSERT(sizeof(unique_file) == sizeof(std::FILE*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<handle, void (*)(handle*)>) == 2 * sizeof(handle*));
+                    }
+                    // C library functions, return values are ignored
+                    {
+                        unique_file file(std::fopen("fn_delete_test.txt", "r"));
+                        unique_cstr str(static_cast<char*>(std::malloc(16)));
+                        boost::unique_ptr<char[], BOOST_UPTR_FN_DELETE(&std::free)> buf(static_cast<char*>(std::malloc(16)));
+                    }
+                    // user functions
+                    {
+                        unique_handle h1(new handle());
+                        unique_handle h2(boost::move(h1));
+                        h2.reset();
+                        boost::unique_ptr<handle, boost::fn_delete<int (*)(handle*), &close_handle> > h3(new handle());
+                        h3.get_deleter()(h3.release());
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // the function has to accept the pointer
+                    {
+                        boost::unique_ptr<int, BOOST_UPTR_FN_DELETE(&destroy_handle)> ptr(new int());
+                    }
+                    // the function type has to match
+                    {
+                        boost::unique_ptr<handle, boost::fn_delete<void (*)(handle*), &close_handle> > ptr;
+                    }
+                    // owners with different functions don't mix
+                    {
+                        boost::unique_ptr<handle, boost::fn_delete<int (*)(handle*), &close_handle> > h1;
+                        unique_handle h2(boost::move(h1));
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//
+// inline_unique_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "inline_unique_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace inline_unique
+            {
+                // no virtual destructor needed
+                class bclass
+                {
+                public:
+                    int val;
+
+                    bclass(void) :
+                        val()
+                    {
+                    }
+
+                    virtual int get(void) const
+                    {
+                        return val;
+                    }
+                };
+
+                class cclass : public bclass
+                {
+                public:
+                    cclass(int val, double)
+                    {
+                        this->val = val;
+                    }
+
+                    virtual int get(void) const
+                    {
+                        return -val;
+                    }
+                };
+
+                class big : public bclass
+                {
+                public:
+                    char data[256];
+                };
+
+                // more aligned than ::operator new guarantees
+                class BOOST_ALIGNMENT(256) over_aligned : public bclass
+                {
+                };
+
+                class other
+                {
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // small objects are stored inline, big ones on the heap
+                    {
+                        BOOST_STATIC_ASSERT(boost::inline_unique<bclass>::fits<cclass>::value);
+                        BOOST_STATIC_ASSERT(!boost::inline_unique<bclass>::fits<big>::value);
+                        BOOST_STATIC_ASSERT(!boost::inline_unique<bclass>::fits<over_aligned>::value);
+                        BOOST_STATIC_ASSERT(sizeof(boost::inline_unique<bclass, 16, 8>) == 16 + 2 * sizeof(void*));
+                    }
+                    // unique_ptr<Base> surface
+                    {
+                        boost::inline_unique<bclass> ptr1;
+                        cclass& c = ptr1.emplace<cclass>(3, 2.5);
+                        int val = ptr1->get() + (*ptr1).get() + ptr1.get()->get();
+                        bool inl = ptr1.is_inline();
+                        (void)c;
+                        (void)val;
+                        (void)inl;
+                        if(ptr1 && !ptr1)
+                        {
+                        }
+                        ptr1.emplace<big>();
+                        ptr1.emplace<bclass>();
+                        ptr1.emplace<over_aligned>();
+                        ptr1.reset(new cclass(1, 0.5));
+                        ptr1.reset();
+                    }
+                    // moving
+                    {
+                        boost::inline_unique<bclass, 32> ptr1;
+                        ptr1.emplace<cclass>(3, 2.5);
+                        boost::inline_unique<bclass, 32> ptr2(boost::move(ptr1));
+                        ptr1 = boost::move(ptr2);
+                        swap(ptr1, ptr2);
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // can't be copied
+                    {
+                        boost::inline_unique<bclass> ptr1;
+                        boost::inline_unique<bclass> ptr2(ptr1);
+                    }
+                    // only types derived from Base
+                    {
+                        boost::inline_unique<bclass> ptr;
+                        ptr.emplace<other>();
+                    }
+                    // different capacities don't mix
+                    {
+                        boost::inline_unique<bclass, 16> ptr1;
+                        boost::inline_unique<bclass, 32> ptr2(boost::move(ptr1));
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
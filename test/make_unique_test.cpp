@@ -0,0 +1,159 @@
+//
+// make_unique_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "make_unique_test.hpp"
+#include <string>
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace make_unique
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    bclass(void) :
+                        val()
+                    {
+                    }
+
+                    explicit bclass(int val) :
+                        val(val)
+                    {
+                    }
+
+                    virtual ~bclass()
+                    {}
+                };
+
+                class cclass : public bclass
+                {
+                public:
+                    cclass(int val, const std::string& name) :
+                        bclass(val), name(name)
+                    {
+                    }
+
+                    std::string name;
+                };
+
+                class movable
+                {
+                    BOOST_MOVABLE_BUT_NOT_COPYABLE(movable)
+                public:
+                    movable(void)
+                    {
+                    }
+
+                    movable(BOOST_RV_REF(movable))
+                    {
+                    }
+
+                    movable& operator=(BOOST_RV_REF(movable))
+                    {
+                        return *this;
+                    }
+                };
+
+                class many_args
+                {
+                public:
+                    many_args(int, int, int, int, int, int, int, int, int, int)
+                    {
+                    }
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // single object, no arguments value-initializes T
+                    {
+                        boost::unique_ptr<int> ptr1 = boost::make_unique<int>();
+                        boost::unique_ptr<bclass> ptr2 = boost::make_unique<bclass>();
+                    }
+                    // single object, arguments are forwarded to T's constructor
+                    {
+                        const std::string name("name");
+                        boost::unique_ptr<int> ptr1 = boost::make_unique<int>(3);
+                        boost::unique_ptr<bclass> ptr2 = boost::make_unique<bclass>(3);
+                        boost::unique_ptr<cclass> ptr3 = boost::make_unique<cclass>(3, name);
+                        boost::unique_ptr<many_args> ptr4 = boost::make_unique<many_args>(1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+                    }
+                    // single object, move-only arguments are moved into T's constructor
+                    {
+                        movable m;
+                        boost::unique_ptr<movable> ptr1 = boost::make_unique<movable>(boost::move(m));
+                    }
+                    // result can be moved to a unique_ptr of a base class
+                    // limitation of C++03: the converting move needs a named unique_ptr<U> (boost::rv can't bind temporaries)
+                    {
+                        boost::unique_ptr<cclass> ptr1 = boost::make_unique<cclass>(3, "name");
+                        boost::unique_ptr<bclass> ptr2(boost::move(ptr1));
+                        ptr1 = boost::make_unique<cclass>(4, "other");
+                        ptr2 = boost::move(ptr1);
+                    }
+                    // array of unknown bound value-initializes n elements
+                    {
+                        boost::unique_ptr<int[]> ptr1 = boost::make_unique<int[]>(5);
+                        boost::unique_ptr<bclass[]> ptr2 = boost::make_unique<bclass[]>(2);
+                    }
+                    // default-initialized single object and array
+                    {
+                        boost::unique_ptr<int> ptr1 = boost::make_unique_for_overwrite<int>();
+                        boost::unique_ptr<int[]> ptr2 = boost::make_unique_for_overwrite<int[]>(5);
+                        boost::unique_ptr<bclass[]> ptr3 = boost::make_unique_for_overwrite<bclass[]>(2);
+                    }
+                    // zero-initialized array is released with free_delete
+                    {
+                        boost::unique_ptr<int[], boost::free_delete<int[]> > ptr1 = boost::make_unique_zeroed<int[]>(5);
+                        boost::unique_ptr<double[], boost::free_delete<double[]> > ptr2 = boost::make_unique_zeroed<double[]>(0);
+                        BOOST_STATIC_ASSERT(sizeof(ptr1) == sizeof(int*));
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // arrays of known bound can't be created
+                    {
+                        boost::make_unique<int[2]>();
+                        boost::make_unique<int[2]>(2);
+                    }
+                    // make_unique_zeroed can't construct non-POD types
+                    {
+                        boost::make_unique_zeroed<bclass[]>(2);
+                    }
+                    // make_unique_zeroed only creates arrays of unknown bound
+                    {
+                        boost::make_unique_zeroed<int>(2);
+                        boost::make_unique_zeroed<int[2]>(2);
+                    }
+                    // copy-only construction from a move-only argument
+                    {
+                        movable m;
+                        boost::unique_ptr<movable> ptr1 = boost::make_unique<movable>(m);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,92 @@
+//
+// mapped_file_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "mapped_file_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace mapped_file
+            {
+                struct record
+                {
+                    int key;
+                    int value;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // unique_ptr uses unmap_file::pointer
+                    {
+                        boost::unique_ptr<void, boost::unmap_file> ptr1;
+                        boost::unique_ptr<void, boost::unmap_file> ptr2(boost::file_mapping(0, 0, -1, false));
+                        boost::file_mapping m = ptr2.get();
+                        std::size_t n = ptr2->length;
+                        bool b = ptr1 == ptr2 || !ptr1;
+                        (void)m;
+                        (void)n;
+                        (void)b;
+                        ptr1 = boost::move(ptr2);
+                        ptr1.reset();
+                    }
+                    // factories, views and hints
+                    {
+                        boost::mapped_file file1 = boost::map_readonly("index.bin");
+                        boost::mapped_file file2 = boost::map_readwrite("index.bin");
+                        const record* r = file1.view<const record>();
+                        std::size_t n = file1.count<record>() + file1.size();
+                        file2.view<record>(sizeof(record))->value = r->value;
+                        bool b = file1.advise(boost::mapped_file::advise_random)
+                            && file1.advise(boost::mapped_file::advise_willneed, 0, 4096);
+                        b = file2.writable() && !file2.empty() && file2.native_handle() >= 0;
+                        (void)n;
+                        (void)b;
+                    }
+                    // mapped files are movable
+                    {
+                        boost::mapped_file file1;
+                        boost::mapped_file file2(boost::move(file1));
+                        file1 = boost::move(file2);
+                        swap(file1, file2);
+                        boost::file_mapping m = file1.release();
+                        boost::mapped_file file3(m);
+                        file3.reset();
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // mapped files can't be copied
+                    {
+                        boost::mapped_file file1;
+                        boost::mapped_file file2(file1);
+                    }
+                    // a mapping isn't a raw pointer
+                    {
+                        int i;
+                        boost::unique_ptr<void, boost::unmap_file> ptr1(&i);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
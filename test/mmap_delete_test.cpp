@@ -0,0 +1,92 @@
+//
+// mmap_delete_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "mmap_delete_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace mmap_delete
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    bclass(void) :
+                        val(1)
+                    {
+                    }
+
+                    virtual ~bclass()
+                    {}
+                };
+
+                class cclass : public bclass
+                {
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // mmap_delete stores the element count and the mapping length
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[], boost::mmap_delete<int[]> >) == 3 * sizeof(int*));
+                    }
+                    // page behavior options
+                    {
+                        boost::unique_ptr<int[], boost::mmap_delete<int[]> > ptr1 = boost::make_unique_mapped<int[]>(1024);
+                        boost::unique_ptr<int[], boost::mmap_delete<int[]> > ptr2 = boost::make_unique_mapped<int[]>(1024,
+                            boost::map_huge_pages | boost::map_populate);
+                        boost::unique_ptr<int[], boost::mmap_delete<int[]> > ptr3 = boost::make_unique_mapped<int[]>(1024,
+                            boost::map_lock);
+                        ptr1 = boost::move(ptr2);
+                        std::size_t n = ptr1.get_deleter().size() + ptr1.get_deleter().length();
+                        (void)n;
+                    }
+                    // elements are value-initialized
+                    {
+                        boost::unique_ptr<bclass[], boost::mmap_delete<bclass[]> > ptr1 = boost::make_unique_mapped<bclass[]>(4);
+                        ptr1[3].val = 2;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // only arrays can be mapped
+                    {
+                        boost::make_unique_mapped<int>(1);
+                    }
+                    // mmap_delete<U[]> can't delete an array of a different type
+                    {
+                        const boost::mmap_delete<bclass[]> del;
+                        cclass* c = 0;
+                        del(c);
+                    }
+                    // arrays of known bound can't be created
+                    {
+                        boost::make_unique_mapped<int[2]>(1);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
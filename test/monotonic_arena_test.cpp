@@ -0,0 +1,111 @@
+//
+// monotonic_arena_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "monotonic_arena_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace monotonic_arena
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    bclass(void) :
+                        val()
+                    {
+                    }
+
+                    virtual ~bclass()
+                    {}
+                };
+
+                class cclass : public bclass
+                {
+                public:
+                    cclass(int val, double)
+                    {
+                        this->val = val;
+                    }
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    boost::monotonic_arena arena;
+                    // arena_delete is empty for single objects and one word for arrays
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int, boost::arena_delete<int> >) == sizeof(int*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[], boost::arena_delete<int[]> >) == 2 * sizeof(int*));
+                    }
+                    // single object
+                    {
+                        boost::unique_ptr<int, boost::arena_delete<int> > ptr1 = boost::make_unique_in<int>(arena);
+                        boost::unique_ptr<int, boost::arena_delete<int> > ptr2 = boost::make_unique_in<int>(arena, 3);
+                        boost::unique_ptr<cclass, boost::arena_delete<cclass> > ptr3 = boost::make_unique_in<cclass>(arena, 3, 2.5);
+                        ptr1 = boost::move(ptr2);
+                    }
+                    // arena_delete<U> is convertible to arena_delete<T> iff U* is implicitly convertible to T*
+                    {
+                        boost::unique_ptr<cclass, boost::arena_delete<cclass> > ptr1 = boost::make_unique_in<cclass>(arena, 3, 2.5);
+                        boost::unique_ptr<bclass, boost::arena_delete<bclass> > ptr2(boost::move(ptr1));
+                    }
+                    // arrays, the element count travels with the deleter
+                    {
+                        boost::unique_ptr<bclass[], boost::arena_delete<bclass[]> > ptr1 = boost::make_unique_in<bclass[]>(arena, 4);
+                        boost::unique_ptr<bclass[], boost::arena_delete<bclass[]> > ptr2(boost::move(ptr1));
+                        std::size_t n = ptr2.get_deleter().size();
+                        ptr2[n - 1].val = 1;
+                    }
+                    // memory is reclaimed in bulk
+                    {
+                        arena.reset();
+                        arena.release();
+                        boost::monotonic_arena arena2(1024);
+                        void* mem = arena2.allocate(16, 16);
+                        if(mem);
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    boost::monotonic_arena arena;
+                    // arenas can't be copied
+                    {
+                        boost::monotonic_arena arena2(arena);
+                    }
+                    // arena_delete<U[]> can't destroy an array of a different type
+                    {
+                        const boost::arena_delete<bclass[]> del(1);
+                        cclass* c = 0;
+                        del(c);
+                    }
+                    // arrays of known bound can't be created
+                    {
+                        boost::make_unique_in<int[2]>(arena);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+//
+// pool_delete_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "pool_delete_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace pool_delete
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    virtual ~bclass()
+                    {}
+                };
+
+                class cclass : public bclass
+                {
+                public:
+                    explicit cclass(int val)
+                    {
+                        this->val = val;
+                    }
+                };
+
+                class large
+                {
+                public:
+                    char data[boost::pool_max_size + 1];
+                };
+
+                // never pooled, blocks are only aligned to pool_granularity
+                struct BOOST_ALIGNMENT(256) over_aligned
+                {
+                    int val;
+                };
+
+                class big_child : public bclass
+                {
+                public:
+                    char data[boost::pool_max_size];
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // pool_delete is stateless
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int, boost::pool_delete<int> >) == sizeof(int*));
+                    }
+                    // pooled and non-pooled (too large) objects
+                    {
+                        boost::unique_ptr<int, boost::pool_delete<int> > ptr1 = boost::make_unique_pooled<int>();
+                        boost::unique_ptr<int, boost::pool_delete<int> > ptr2 = boost::make_unique_pooled<int>(3);
+                        boost::unique_ptr<large, boost::pool_delete<large> > ptr3 = boost::make_unique_pooled<large>();
+                        boost::unique_ptr<over_aligned, boost::pool_delete<over_aligned> > ptr5 = boost::make_unique_pooled<over_aligned>();
+                        ptr1 = boost::move(ptr2);
+                        boost::unique_ptr<int, boost::pool_delete<int> > ptr4(boost::move(ptr1));
+                    }
+                    // pool_delete<U> is convertible to pool_delete<T> iff U* is implicitly convertible to T*
+                    {
+                        boost::unique_ptr<cclass, boost::pool_delete<cclass> > ptr1 = boost::make_unique_pooled<cclass>(3);
+                        boost::unique_ptr<bclass, boost::pool_delete<bclass> > ptr2(boost::move(ptr1));
+                    }
+                    // cross thread batches
+                    {
+                        boost::flush_pool_thread_cache();
+                        boost::release_pool_thread_cache();
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // pool_delete doesn't handle arrays
+                    {
+                        boost::pool_delete<int[]> del;
+                        boost::make_unique_pooled<int[]>(2);
+                    }
+                    // U and T must come from the same allocator
+                    {
+                        boost::unique_ptr<big_child, boost::pool_delete<big_child> > ptr1;
+                        boost::unique_ptr<bclass, boost::pool_delete<bclass> > ptr2(boost::move(ptr1));
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,120 @@
+//
+// rcu_cell_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "rcu_cell_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace rcu_cell
+            {
+                struct table
+                {
+                    int routes[4];
+                };
+
+                // deleter with state
+                struct counting_delete
+                {
+                    counting_delete(void) :
+                        count()
+                    {
+                    }
+
+                    void operator()(const table* ptr) const
+                    {
+                        ++*count;
+                        delete ptr;
+                    }
+
+                    int* count;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // publishing versions
+                    {
+                        boost::rcu_cell<const table> cell1;
+                        boost::rcu_cell<const table> cell2(boost::unique_ptr<const table>(new table()));
+                        cell1.update(boost::unique_ptr<const table>(new table()));
+                        boost::unique_ptr<const table> next(new table());
+                        cell2.update(boost::move(next));
+                    }
+                    // reading
+                    {
+                        boost::rcu_cell<const table> cell(boost::unique_ptr<const table>(new table()));
+                        boost::rcu_cell<const table>::read_ptr ptr1 = cell.read();
+                        boost::rcu_cell<const table>::read_ptr ptr2(ptr1);
+                        int route = ptr1->routes[0] + (*ptr2).routes[1];
+                        const table* raw = ptr1.get();
+                        (void)route;
+                        (void)raw;
+                    }
+                    // explicit read sections
+                    {
+                        boost::rcu_cell<const table> cell;
+                        boost::rcu_read_guard guard;
+                        const table* raw = cell.load();
+                        (void)raw;
+                    }
+                    // stateful deleters
+                    {
+                        int count = 0;
+                        counting_delete del;
+                        del.count = &count;
+                        boost::rcu_cell<const table, counting_delete> cell(
+                            boost::unique_ptr<const table, counting_delete>(new table(), del));
+                        cell.update(boost::unique_ptr<const table, counting_delete>(new table(), del));
+                    }
+                    // reclamation
+                    {
+                        std::size_t pending = boost::rcu_reclaim();
+                        boost::release_rcu_reader();
+                        (void)pending;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // can't be copied
+                    {
+                        boost::rcu_cell<const table> cell1;
+                        boost::rcu_cell<const table> cell2(cell1);
+                    }
+                    // lvalues aren't moved from implicitly
+                    {
+                        boost::rcu_cell<const table> cell;
+                        boost::unique_ptr<const table> ptr;
+                        cell.update(ptr);
+                    }
+                    // read_ptr can't be reseated
+                    {
+                        boost::rcu_cell<const table> cell;
+                        boost::rcu_cell<const table>::read_ptr ptr1 = cell.read();
+                        boost::rcu_cell<const table>::read_ptr ptr2 = cell.read();
+                        ptr1 = ptr2;
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
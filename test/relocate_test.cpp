@@ -0,0 +1,133 @@
+//
+// relocate_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "relocate_test.hpp"
+#include <boost/free_delete.hpp>
+#include "stream_closer.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace relocate
+            {
+                // keeps a pointer into itself, so it can't be relocated bitwise
+                class self_ref
+                {
+                public:
+                    self_ref(void) :
+                        self(this)
+                    {
+                    }
+
+                    self_ref(const self_ref&) :
+                        self(this)
+                    {
+                    }
+
+                    self_ref& operator=(const self_ref&)
+                    {
+                        return *this;
+                    }
+
+                    self_ref* self;
+                };
+
+                struct self_ref_delete
+                {
+                    self_ref_delete(void)
+                    {
+                    }
+
+                    self_ref_delete(const self_ref_delete&)
+                    {
+                    }
+
+                    void operator()(int* ptr) const
+                    {
+                        delete ptr;
+                    }
+
+                    self_ref member;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // trait
+                    {
+                        BOOST_STATIC_ASSERT(boost::is_trivially_relocatable<int>::value);
+                        BOOST_STATIC_ASSERT(boost::is_trivially_relocatable<int*>::value);
+                        BOOST_STATIC_ASSERT(!boost::is_trivially_relocatable<self_ref>::value);
+                        BOOST_STATIC_ASSERT(boost::is_trivially_relocatable<boost::default_delete<int> >::value);
+                        BOOST_STATIC_ASSERT(boost::is_trivially_relocatable<boost::unique_ptr<int> >::value);
+                        BOOST_STATIC_ASSERT(boost::is_trivially_relocatable<boost::unique_ptr<int[]> >::value);
+                        BOOST_STATIC_ASSERT((boost::is_trivially_relocatable<boost::unique_ptr<int, boost::free_delete<int> > >::value));
+                        BOOST_STATIC_ASSERT((boost::is_trivially_relocatable<boost::unique_ptr<int[], boost::free_delete<int[]> > >::value));
+                        BOOST_STATIC_ASSERT((boost::is_trivially_relocatable<boost::unique_ptr<std::fstream, stream_closer&> >::value));
+                        BOOST_STATIC_ASSERT((!boost::is_trivially_relocatable<boost::unique_ptr<int, self_ref_delete> >::value));
+                    }
+                    // relocate unique_ptrs between buffers and within a buffer
+                    {
+                        typedef boost::unique_ptr<int> ptr_type;
+                        void* raw1 = ::operator new(4 * sizeof(ptr_type));
+                        void* raw2 = ::operator new(4 * sizeof(ptr_type));
+                        ptr_type* buf1 = static_cast<ptr_type*>(raw1);
+                        ptr_type* buf2 = static_cast<ptr_type*>(raw2);
+                        for(int i = 0; i < 3; ++i)
+                        {
+                            new (buf1 + i) ptr_type(new int(i));
+                        }
+                        ptr_type* end = boost::uninitialized_relocate(buf1, buf1 + 3, buf2);
+                        end = boost::relocate_n(buf2, 3, buf2 + 1);
+                        boost::relocate_n(buf2 + 1, 3, buf2);
+                        for(ptr_type* p = buf2; p != end - 1; ++p)
+                        {
+                            p->~ptr_type();
+                        }
+                        ::operator delete(raw2);
+                        ::operator delete(raw1);
+                    }
+                    // types which aren't trivially relocatable are moved then destroyed
+                    {
+                        self_ref buf1[2];
+                        void* raw = ::operator new(2 * sizeof(self_ref));
+                        self_ref* buf2 = static_cast<self_ref*>(raw);
+                        boost::uninitialized_relocate(buf1, buf1 + 2, buf2);
+                        new (buf1) self_ref(buf2[0]);
+                        new (buf1 + 1) self_ref(buf2[1]);
+                        ::operator delete(raw);
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // a const range can't be relocated from
+                    {
+                        boost::unique_ptr<int> buf[2];
+                        const boost::unique_ptr<int>* first = buf;
+                        boost::unique_ptr<int>* dest = 0;
+                        boost::uninitialized_relocate(first, first + 2, dest);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+//
+// sized_delete_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "sized_delete_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace sized_delete
+            {
+                class aclass
+                {
+                public:
+                    int val;
+
+                    aclass(void) :
+                        val()
+                    {
+                    }
+
+                    aclass(int val, double) :
+                        val(val)
+                    {
+                    }
+                };
+
+                class bclass
+                {
+                public:
+                    virtual ~bclass()
+                    {}
+                };
+
+                class incomplete;
+
+                // pimpl: the owner can be declared before the type is complete
+                class pimpl_owner
+                {
+                    boost::unique_ptr<incomplete, boost::sized_delete<incomplete> > impl;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // sized_delete is empty for single objects and one word for arrays
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int, boost::sized_delete<int> >) == sizeof(int*));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_ptr<int[], boost::sized_delete<int[]> >) == 2 * sizeof(int*));
+                    }
+                    // single object
+                    {
+                        boost::unique_ptr<int, boost::sized_delete<int> > ptr1 = boost::make_unique_sized<int>();
+                        boost::unique_ptr<int, boost::sized_delete<int> > ptr2 = boost::make_unique_sized<int>(3);
+                        boost::unique_ptr<aclass, boost::sized_delete<aclass> > ptr3 = boost::make_unique_sized<aclass>(3, 2.5);
+                        ptr1 = boost::move(ptr2);
+                        boost::unique_ptr<const aclass, boost::sized_delete<const aclass> > ptr4 =
+                            boost::make_unique_sized<const aclass>(4, 0.5);
+                    }
+                    // arrays, the element count travels with the deleter
+                    {
+                        boost::unique_ptr<aclass[], boost::sized_delete<aclass[]> > ptr1 = boost::make_unique_sized<aclass[]>(4);
+                        boost::unique_ptr<aclass[], boost::sized_delete<aclass[]> > ptr2(boost::move(ptr1));
+                        std::size_t n = ptr2.get_deleter().size();
+                        ptr2[n - 1].val = 1;
+                        boost::unique_ptr<const int[], boost::sized_delete<const int[]> > ptr3 =
+                            boost::make_unique_sized<const int[]>(2);
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // the size of a derived object isn't known statically
+                    {
+                        boost::unique_ptr<bclass, boost::sized_delete<bclass> > ptr1;
+                    }
+                    // sized_delete<T[]> can't delete an array of a different type
+                    {
+                        const boost::sized_delete<int[]> del(1);
+                        long* l = 0;
+                        del(l);
+                    }
+                    // arrays of known bound can't be created
+                    {
+                        boost::make_unique_sized<int[2]>();
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+//
+// tagged_unique_ptr_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "tagged_unique_ptr_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace tagged_unique_ptr
+            {
+                struct node
+                {
+                    boost::tagged_unique_ptr<node, 2> left;
+                    boost::tagged_unique_ptr<node, 2> right;
+                    int key;
+                };
+
+                // deleter with state
+                struct counting_delete
+                {
+                    counting_delete(void) :
+                        count()
+                    {
+                    }
+
+                    void operator()(node* ptr) const
+                    {
+                        ++*count;
+                        delete ptr;
+                    }
+
+                    int* count;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // tags take no space
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::tagged_unique_ptr<node, 2>) == sizeof(node*));
+                        BOOST_STATIC_ASSERT(sizeof(node) == 2 * sizeof(node*) + sizeof(node*));
+                        BOOST_STATIC_ASSERT(boost::tagged_unique_ptr<node, 2>::tag_mask == 3);
+                        BOOST_STATIC_ASSERT(boost::is_trivially_relocatable<boost::tagged_unique_ptr<node, 2> >::value);
+                    }
+                    // ownership and tags
+                    {
+                        boost::tagged_unique_ptr<node, 2> ptr1;
+                        boost::tagged_unique_ptr<node, 2> ptr2(new node(), 1);
+                        ptr2->key = 1;
+                        (*ptr2).key = 2;
+                        ptr2.set_tag(3);
+                        std::size_t tag = ptr2.tag();
+                        (void)tag;
+                        ptr1 = boost::move(ptr2);
+                        boost::tagged_unique_ptr<node, 2> ptr3(boost::move(ptr1));
+                        node* raw = ptr3.release();
+                        ptr3.reset(raw);
+                        ptr3.reset();
+                        swap(ptr1, ptr3);
+                        if(ptr1 || !ptr2 || ptr1 == ptr2 || ptr1 != ptr2 || ptr1 < ptr2)
+                        {
+                        }
+                    }
+                    // from unique_ptr
+                    {
+                        boost::unique_ptr<node> ptr(new node());
+                        boost::tagged_unique_ptr<node, 2> tagged(boost::move(ptr), 2);
+                        boost::unique_ptr<node> back(tagged.release());
+                    }
+                    // stateful deleters
+                    {
+                        int count = 0;
+                        counting_delete d;
+                        d.count = &count;
+                        boost::tagged_unique_ptr<node, 1, counting_delete> ptr1(new node(), 1, d);
+                        boost::tagged_unique_ptr<node, 1, counting_delete> ptr2(boost::move(ptr1));
+                        ptr2.get_deleter().count = &count;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // can't be copied
+                    {
+                        boost::tagged_unique_ptr<node, 2> ptr1;
+                        boost::tagged_unique_ptr<node, 2> ptr2(ptr1);
+                    }
+                    // more tag bits than the alignment leaves
+                    {
+                        boost::tagged_unique_ptr<char, 1> ptr;
+                    }
+                    // lvalues aren't moved from implicitly
+                    {
+                        boost::unique_ptr<node> ptr;
+                        boost::tagged_unique_ptr<node, 2> tagged(ptr);
+                    }
+                    // no arrays
+                    {
+                        boost::tagged_unique_ptr<node[], 2> ptr;
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
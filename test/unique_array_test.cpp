@@ -0,0 +1,98 @@
+//
+// unique_array_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "unique_array_test.hpp"
+#include <boost/monotonic_arena.hpp>
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace unique_array
+            {
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // the length is stored in the deleter
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_array<int>) == 2 * sizeof(int*));
+                    }
+                    // construction, iteration and element access
+                    {
+                        boost::unique_array<int> arr1;
+                        boost::unique_array<int> arr2 = boost::make_unique_array<int>(4);
+                        for(boost::unique_array<int>::iterator i = arr2.begin(); i != arr2.end(); ++i)
+                        {
+                            *i = 1;
+                        }
+                        const boost::unique_array<int>& carr = arr2;
+                        int sum = 0;
+                        for(boost::unique_array<int>::const_iterator i = carr.begin(); i != carr.end(); ++i)
+                        {
+                            sum += *i;
+                        }
+                        arr2[0] = carr[1] + carr.data()[2];
+                        std::size_t n = carr.size();
+                        bool b = carr.empty();
+                        (void)n;
+                        (void)b;
+                    }
+                    // moving, swapping, releasing
+                    {
+                        boost::unique_array<int> arr1 = boost::make_unique_array<int>(4);
+                        boost::unique_array<int> arr2(boost::move(arr1));
+                        arr1 = boost::move(arr2);
+                        swap(arr1, arr2);
+                        std::size_t n = arr2.get_deleter().size();
+                        int* p = arr2.release();
+                        boost::unique_array<int> arr3(p, boost::sized_delete<int[]>(n));
+                        arr3.reset();
+                    }
+                    // adopting unique_ptr<T[], D> whose deleter knows the count
+                    {
+                        boost::unique_ptr<int[], boost::sized_delete<int[]> > ptr = boost::make_unique_sized<int[]>(4);
+                        boost::unique_array<int> arr1(boost::move(ptr));
+                        boost::monotonic_arena arena;
+                        boost::unique_array<int, boost::arena_delete<int[]> > arr2(boost::make_unique_in<int[]>(arena, 4));
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // arrays can't be copied
+                    {
+                        boost::unique_array<int> arr1;
+                        boost::unique_array<int> arr2(arr1);
+                    }
+                    // owners can't be copied in
+                    {
+                        boost::unique_ptr<int[], boost::sized_delete<int[]> > ptr;
+                        boost::unique_array<int> arr(ptr);
+                    }
+                    // the deleter has to know the length
+                    {
+                        boost::unique_array<int, boost::default_delete<int[]> > arr(boost::make_unique<int[]>(4));
+                        arr.size();
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+//
+// unique_resource_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "unique_resource_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace unique_resource
+            {
+                // deleter with state
+                struct counting_close
+                {
+                    counting_close(void) :
+                        closed()
+                    {
+                    }
+
+                    void operator()(long) const
+                    {
+                        ++*closed;
+                    }
+
+                    int* closed;
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // empty deleters take no space
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_fd) == sizeof(int));
+                        BOOST_STATIC_ASSERT(sizeof(boost::unique_socket) == sizeof(int));
+                        BOOST_STATIC_ASSERT(boost::is_trivially_relocatable<boost::unique_fd>::value);
+                        BOOST_STATIC_ASSERT(boost::unique_fd::invalid == -1);
+                    }
+                    // ownership
+                    {
+                        boost::unique_fd fd1;
+                        boost::unique_fd fd2(3);
+                        int h = fd2.get();
+                        fd1 = boost::move(fd2);
+                        boost::unique_fd fd3(boost::move(fd1));
+                        h = fd3.release();
+                        fd3.reset(h);
+                        fd3.reset();
+                        swap(fd1, fd3);
+                        if(fd1 || !fd2 || fd1 == fd2 || fd1 != fd2 || fd1 < fd2)
+                        {
+                        }
+                    }
+                    // socket and epoll owners
+                    {
+                        boost::unique_socket s(-1);
+                        boost::unique_epoll e(-1);
+                    }
+                    // custom handles and deleters
+                    {
+                        int closed = 0;
+                        counting_close del;
+                        del.closed = &closed;
+                        boost::unique_resource<long, counting_close, 0> r1(1, del);
+                        boost::unique_resource<long, counting_close, 0> r2(boost::move(r1));
+                        r2.get_deleter().closed = &closed;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // owners can't be copied
+                    {
+                        boost::unique_fd fd1;
+                        boost::unique_fd fd2(fd1);
+                    }
+                    // handles aren't implicitly owned
+                    {
+                        boost::unique_fd fd1 = 3;
+                    }
+                    // different kinds of descriptors don't mix
+                    {
+                        boost::unique_socket s;
+                        boost::unique_fd fd(boost::move(s));
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
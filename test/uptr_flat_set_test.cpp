@@ -0,0 +1,130 @@
+//
+// uptr_flat_set_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "uptr_flat_set_test.hpp"
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace uptr_flat_set
+            {
+                class bclass
+                {
+                public:
+                    int val;
+                };
+
+                struct counting_delete
+                {
+                    int* deleted;
+
+                    counting_delete(void) :
+                        deleted()
+                    {
+                    }
+
+                    explicit counting_delete(int* deleted) :
+                        deleted(deleted)
+                    {
+                    }
+
+                    void operator()(bclass* ptr) const
+                    {
+                        ++*deleted;
+                        delete ptr;
+                    }
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // hashing unique_ptr hashes get()
+                    {
+                        boost::unique_ptr<bclass> ptr(new bclass);
+                        std::size_t h = boost::hash<boost::unique_ptr<bclass> >()(ptr);
+                        h = boost::hash_value(ptr);
+                        h = boost::hash<boost::unique_ptr<bclass[]> >()(boost::unique_ptr<bclass[]>());
+                        (void)h;
+                    }
+                    // empty deleters take no space
+                    {
+                        BOOST_STATIC_ASSERT(sizeof(boost::uptr_flat_set<bclass>) <= sizeof(bclass**) + 3 * sizeof(std::size_t));
+                    }
+                    // insert, lookup and erase by raw pointer
+                    {
+                        boost::uptr_flat_set<bclass> set;
+                        set.reserve(10);
+                        boost::unique_ptr<bclass> ptr(new bclass);
+                        bclass* raw = set.insert(boost::move(ptr));
+                        const bclass* craw = raw;
+                        bool found = set.contains(raw) && set.contains(craw);
+                        boost::unique_ptr<bclass> back = set.extract(craw);
+                        (void)found;
+                        set.insert(boost::move(back));
+                        set.erase(raw);
+                        std::size_t n = set.size() + set.capacity();
+                        (void)n;
+                        if(set.empty())
+                        {
+                        }
+                        for(boost::uptr_flat_set<bclass>::const_iterator it = set.begin(); it != set.end(); ++it)
+                        {
+                            bclass* p = *it;
+                            (void)p;
+                        }
+                        set.clear();
+                    }
+                    // stateful deleter, moves and swap
+                    {
+                        int deleted = 0;
+                        boost::uptr_flat_set<bclass, counting_delete> set1((counting_delete(&deleted)));
+                        boost::unique_ptr<bclass, counting_delete> ptr(new bclass, counting_delete(&deleted));
+                        set1.insert(boost::move(ptr));
+                        boost::uptr_flat_set<bclass, counting_delete> set2(boost::move(set1));
+                        set1 = boost::move(set2);
+                        swap(set1, set2);
+                        counting_delete& d = set2.get_deleter();
+                        (void)d;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // can't insert lvalues
+                    {
+                        boost::uptr_flat_set<bclass> set;
+                        boost::unique_ptr<bclass> ptr(new bclass);
+                        set.insert(ptr);
+                    }
+                    // can't be copied
+                    {
+                        boost::uptr_flat_set<bclass> set1;
+                        boost::uptr_flat_set<bclass> set2(set1);
+                    }
+                    // no arrays
+                    {
+                        boost::uptr_flat_set<bclass[]> set;
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
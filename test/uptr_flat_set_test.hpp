@@ -0,0 +1,41 @@
+//
+// uptr_flat_set_test.hpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef UPTR_FLAT_SET_TEST_HPP_
+#define UPTR_FLAT_SET_TEST_HPP_
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/uptr_flat_set.hpp>
+#include <boost/functional/hash.hpp>
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace uptr_flat_set
+            {
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void);
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void);
+#endif
+            }
+        }
+    }
+}
+
+#endif // UPTR_FLAT_SET_TEST_HPP_
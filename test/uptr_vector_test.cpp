@@ -0,0 +1,115 @@
+//
+// uptr_vector_test.cpp
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//#define BOOST_UPTR_INVALID_TESTS
+
+#include "uptr_vector_test.hpp"
+#include <boost/free_delete.hpp>
+
+namespace boost
+{
+    namespace uptr
+    {
+        namespace test
+        {
+            namespace uptr_vector
+            {
+                class bclass
+                {
+                public:
+                    int val;
+
+                    bclass(void) :
+                        val()
+                    {
+                    }
+
+                    bclass(int val, double) :
+                        val(val)
+                    {
+                    }
+
+                    virtual ~bclass()
+                    {}
+                };
+
+                /**
+                 * Tests here should compile successfully
+                 */
+                void valid_compile_test(void)
+                {
+                    // push_back, emplace_back, element access
+                    {
+                        boost::uptr_vector<bclass> vec;
+                        boost::unique_ptr<bclass> ptr(new bclass);
+                        vec.push_back(boost::move(ptr));
+                        vec.push_back(boost::unique_ptr<bclass>(new bclass));
+                        vec.emplace_back();
+                        vec.emplace_back(1, 2.5);
+                        vec.reserve(8);
+                        vec[0]->val = vec.at(1)->val + vec.front()->val + vec.back()->val;
+                        const boost::uptr_vector<bclass>& cvec = vec;
+                        for(boost::uptr_vector<bclass>::const_iterator i = cvec.begin(); i != cvec.end(); ++i)
+                        {
+                            (*i)->val;
+                        }
+                        std::size_t n = vec.size() + vec.capacity();
+                        bool b = vec.empty();
+                        (void)n;
+                        (void)b;
+                    }
+                    // insert and erase
+                    {
+                        boost::uptr_vector<int> vec;
+                        vec.emplace_back(1);
+                        boost::uptr_vector<int>::iterator i = vec.insert(vec.begin(), boost::unique_ptr<int>(new int(0)));
+                        i = vec.insert(vec.end(), boost::move(vec[0]));
+                        i = vec.erase(i);
+                        vec.pop_back();
+                        i = vec.erase(vec.begin(), vec.end());
+                        vec.clear();
+                    }
+                    // vectors are movable
+                    {
+                        boost::uptr_vector<int> vec1;
+                        boost::uptr_vector<int> vec2(boost::move(vec1));
+                        vec1 = boost::move(vec2);
+                        swap(vec1, vec2);
+                    }
+                    // arrays and custom deleters
+                    {
+                        boost::uptr_vector<int[]> vec1;
+                        vec1.push_back(boost::unique_ptr<int[]>(new int[2]));
+                        boost::uptr_vector<int, boost::free_delete<int> > vec2;
+                    }
+                }
+
+#if defined(BOOST_UPTR_INVALID_TESTS)
+                /**
+                 * Tests here should all fail to compile
+                 */
+                void invalid_compile_test(void)
+                {
+                    // vectors can't be copied
+                    {
+                        boost::uptr_vector<int> vec1;
+                        boost::uptr_vector<int> vec2(vec1);
+                    }
+                    // elements can't be copied in
+                    {
+                        boost::uptr_vector<int> vec;
+                        boost::unique_ptr<int> ptr;
+                        vec.push_back(ptr);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
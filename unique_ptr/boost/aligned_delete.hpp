@@ -0,0 +1,328 @@
+//
+// aligned_delete.hpp
+//
+// Over-aligned objects and arrays owned by unique_ptr.
+//
+// Before C++17 new ignores alignment beyond that of fundamental types, so over-aligned objects
+// (cache line sized counters, SIMD blocks) may end up misaligned. make_unique_aligned allocates with
+// posix_memalign/_aligned_malloc instead:
+//
+//  make_unique_aligned<T>(align, args...)  returns unique_ptr<T, aligned_delete<T> >
+//  make_unique_aligned<T[]>(n, align)      returns unique_ptr<T[], aligned_delete<T[]> >
+//  make_unique_aligned<T, Align>(args...)  returns unique_ptr<T, aligned_delete<T, Align> >
+//  make_unique_aligned<T[], Align>(n)      returns unique_ptr<T[], aligned_delete<T[], Align> >
+//
+// The alignment used is the larger of align and alignof(T). A runtime align must be a power of 2, otherwise
+// std::invalid_argument is thrown. A compile time Align is checked by aligned_delete and recorded in its type.
+//
+// The Align parameter of aligned_delete<T, Align> is the alignment its objects are known to have
+// (alignof(T) by default); it is checked at compile time and only converts to weaker guarantees.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_ALIGNED_DELETE_HPP
+#define BOOST_ALIGNED_DELETE_HPP
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <boost/make_unique.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/remove_extent.hpp>
+#include <boost/unique_ptr/detail/uptr_aligned.hpp>
+#include <boost/utility/enable_if.hpp>
+
+namespace boost
+{
+    /**
+     * Deleter for objects created by make_unique_aligned<T>.
+     */
+    template<class T, std::size_t Align = alignment_of<typename remove_extent<T>::type>::value>
+    struct aligned_delete
+    {
+        BOOST_STATIC_ASSERT_MSG(Align != 0 && (Align & (Align - 1)) == 0, "Align must be a power of 2.");
+        BOOST_STATIC_ASSERT_MSG(Align >= alignment_of<T>::value, "Align is weaker than the alignment of T.");
+
+    private:
+        // Used for testing if templated copy constructor can participate in overload resolution
+        struct nat
+        {
+        };
+
+    public:
+        BOOST_STATIC_CONSTANT(std::size_t, alignment = Align);
+
+        aligned_delete(void)
+        {
+        }
+
+        /**
+         * Allowed iff U* is implicitly convertible to T* and B is at least as strict as Align.
+         */
+        template<class U, std::size_t B>
+        aligned_delete(const aligned_delete<U, B>&, typename enable_if_c<
+                is_convertible<U*, T*>::value && B >= Align, nat>::type = nat())
+        {
+        }
+
+        /**
+         * Equivalent to: ptr->~T(); aligned_free(ptr);
+         * For polymorphic types the whole object is freed, even if ptr points to a base class subobject.
+         */
+        void operator()(T* ptr) const
+        {
+            void* block = ::boost::uptr_detail::block_of(ptr);
+            ptr->~T();
+            ::boost::uptr_detail::aligned_free(block);
+        }
+    };
+
+    // array specialization
+    // stores the element count so every element can be destroyed
+    template<class T, std::size_t Align>
+    struct aligned_delete<T[], Align>
+    {
+        BOOST_STATIC_ASSERT_MSG(Align != 0 && (Align & (Align - 1)) == 0, "Align must be a power of 2.");
+        BOOST_STATIC_ASSERT_MSG(Align >= alignment_of<T>::value, "Align is weaker than the alignment of T.");
+
+        BOOST_STATIC_CONSTANT(std::size_t, alignment = Align);
+
+        aligned_delete(void) :
+            count()
+        {
+        }
+
+        explicit aligned_delete(std::size_t count) :
+            count(count)
+        {
+        }
+
+#if defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+    private:
+        // prevents deleting an array of U
+        template<class U> void operator()(U*) const;
+    public:
+#else
+        template<class U> void operator()(U*) const = delete;
+#endif
+
+        /**
+         * Destroys all elements in reverse order, then equivalent to: aligned_free(ptr);
+         */
+        void operator()(T* ptr) const
+        {
+            if(!has_trivial_destructor<T>::value)
+            {
+                for(std::size_t i = count; i > 0; --i)
+                {
+                    ptr[i - 1].~T();
+                }
+            }
+            ::boost::uptr_detail::aligned_free(ptr);
+        }
+
+        std::size_t size(void) const
+        {
+            return count;
+        }
+
+    private:
+        std::size_t count;
+    };
+
+    namespace uptr_detail
+    {
+        template<typename T, std::size_t Align = alignment_of<typename remove_extent<T>::type>::value>
+        struct make_unique_aligned_switch
+        {
+            typedef ::boost::unique_ptr<T, ::boost::aligned_delete<T, Align> > single_object;
+        };
+
+        template<typename T, std::size_t Align>
+        struct make_unique_aligned_switch<T[], Align>
+        {
+            typedef ::boost::unique_ptr<T[], ::boost::aligned_delete<T[], Align> > unknown_bound;
+        };
+
+        template<typename T, std::size_t N, std::size_t Align>
+        struct make_unique_aligned_switch<T[N], Align>
+        {
+            typedef void known_bound;
+        };
+
+        // frees the block if the constructor throws
+        class aligned_construct_guard
+        {
+        public:
+            aligned_construct_guard(std::size_t size, std::size_t align, std::size_t min_align) :
+                block()
+            {
+                if(align == 0 || (align & (align - 1)) != 0)
+                {
+                    throw std::invalid_argument("make_unique_aligned: alignment must be a power of 2");
+                }
+                // posix_memalign also needs a multiple of sizeof(void*)
+                if(align < min_align)
+                {
+                    align = min_align;
+                }
+                if(align < sizeof(void*))
+                {
+                    align = sizeof(void*);
+                }
+                block = aligned_malloc(size == 0 ? 1 : size, align);
+                if(block == 0)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+
+            ~aligned_construct_guard(void)
+            {
+                if(block != 0)
+                {
+                    aligned_free(block);
+                }
+            }
+
+            template<typename P>
+            P release(P p)
+            {
+                block = 0;
+                return p;
+            }
+
+            void* block;
+        };
+
+        // n value-initialized elements, destroyed again if one of the constructors throws
+        template<typename Result>
+        inline Result make_aligned_array(std::size_t n, std::size_t align)
+        {
+            typedef typename Result::element_type element_type;
+            if(n > static_cast<std::size_t>(-1) / sizeof(element_type))
+            {
+                throw std::bad_alloc();
+            }
+            aligned_construct_guard guard(n * sizeof(element_type), align, alignment_of<element_type>::value);
+            element_type* mem = static_cast<element_type*>(guard.block);
+            std::size_t i = 0;
+            try
+            {
+                for(; i < n; ++i)
+                {
+                    new (mem + i) element_type();
+                }
+            }
+            catch(...)
+            {
+                for(; i > 0; --i)
+                {
+                    mem[i - 1].~element_type();
+                }
+                throw;
+            }
+            return Result(guard.release(mem), typename Result::deleter_type(n));
+        }
+    }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    /**
+     * Constructs T(std::forward<Args>(args)...) in memory aligned to at least align bytes.
+     */
+    template<typename T, typename... Args>
+    inline typename ::boost::uptr_detail::make_unique_aligned_switch<T>::single_object
+    make_unique_aligned(std::size_t align, Args&&... args)
+    {
+        ::boost::uptr_detail::aligned_construct_guard guard(sizeof(T), align, alignment_of<T>::value);
+        return typename ::boost::uptr_detail::make_unique_aligned_switch<T>::single_object(
+            guard.release(new (guard.block) T(::boost::uptr_detail::forward<Args>(args)...)));
+    }
+#else
+    /**
+     * Constructs T(a0, ..., an-1) in memory aligned to at least align bytes.
+     */
+#define BOOST_UPTR_MAKE_UNIQUE_ALIGNED(z, n, data) \
+    template<typename T BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+    inline typename ::boost::uptr_detail::make_unique_aligned_switch<T>::single_object \
+    make_unique_aligned(std::size_t align BOOST_UPTR_FWD_TRAILING_PARAMS(n)) \
+    { \
+        ::boost::uptr_detail::aligned_construct_guard guard(sizeof(T), align, alignment_of<T>::value); \
+        return typename ::boost::uptr_detail::make_unique_aligned_switch<T>::single_object( \
+            guard.release(new (guard.block) T(BOOST_UPTR_FWD_ARGS(n)))); \
+    }
+
+    BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_MAKE_UNIQUE_ALIGNED, ~)
+
+#undef BOOST_UPTR_MAKE_UNIQUE_ALIGNED
+#endif
+
+    /**
+     * Array of n value-initialized elements, the first aligned to at least align bytes.
+     */
+    template<typename T>
+    inline typename ::boost::uptr_detail::make_unique_aligned_switch<T>::unknown_bound
+    make_unique_aligned(std::size_t n, std::size_t align)
+    {
+        return ::boost::uptr_detail::make_aligned_array<
+            typename ::boost::uptr_detail::make_unique_aligned_switch<T>::unknown_bound>(n, align);
+    }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    /**
+     * Constructs T(std::forward<Args>(args)...) in memory aligned to Align bytes, which the deleter type records.
+     */
+    template<typename T, std::size_t Align, typename... Args>
+    inline typename ::boost::uptr_detail::make_unique_aligned_switch<T, Align>::single_object
+    make_unique_aligned(Args&&... args)
+    {
+        ::boost::uptr_detail::aligned_construct_guard guard(sizeof(T), Align, alignment_of<T>::value);
+        return typename ::boost::uptr_detail::make_unique_aligned_switch<T, Align>::single_object(
+            guard.release(new (guard.block) T(::boost::uptr_detail::forward<Args>(args)...)));
+    }
+#else
+    /**
+     * Constructs T(a0, ..., an-1) in memory aligned to Align bytes, which the deleter type records.
+     */
+#define BOOST_UPTR_MAKE_UNIQUE_ALIGNED(z, n, data) \
+    template<typename T, std::size_t Align BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+    inline typename ::boost::uptr_detail::make_unique_aligned_switch<T, Align>::single_object \
+    make_unique_aligned(BOOST_UPTR_FWD_PARAMS(n)) \
+    { \
+        ::boost::uptr_detail::aligned_construct_guard guard(sizeof(T), Align, alignment_of<T>::value); \
+        return typename ::boost::uptr_detail::make_unique_aligned_switch<T, Align>::single_object( \
+            guard.release(new (guard.block) T(BOOST_UPTR_FWD_ARGS(n)))); \
+    }
+
+    BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_MAKE_UNIQUE_ALIGNED, ~)
+
+#undef BOOST_UPTR_MAKE_UNIQUE_ALIGNED
+#endif
+
+    /**
+     * Array of n value-initialized elements, the first aligned to Align bytes, which the deleter type records.
+     */
+    template<typename T, std::size_t Align>
+    inline typename ::boost::uptr_detail::make_unique_aligned_switch<T, Align>::unknown_bound
+    make_unique_aligned(std::size_t n)
+    {
+        return ::boost::uptr_detail::make_aligned_array<
+            typename ::boost::uptr_detail::make_unique_aligned_switch<T, Align>::unknown_bound>(n, Align);
+    }
+
+    // arrays of known bound can't be created with make_unique_aligned
+#if !defined(BOOST_NO_CXX11_DELETED_FUNCTIONS) && defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    template<typename T, typename... Args>
+    typename ::boost::uptr_detail::make_unique_aligned_switch<T>::known_bound
+    make_unique_aligned(Args&&...) = delete;
+#endif
+}
+
+#endif // BOOST_ALIGNED_DELETE_HPP
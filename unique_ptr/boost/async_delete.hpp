@@ -0,0 +1,427 @@
+//
+// async_delete.hpp
+//
+// Destruction on a background thread, for objects which take too long to destroy on a serving thread.
+//
+// async_delete<T> is a drop-in deleter: unique_ptr<T, async_delete<T> > hands its object to a reclaimer
+// thread (started on first use) through a bounded lock-free multi-producer queue and returns immediately.
+//
+// When BOOST_UPTR_ASYNC_QUEUE_SIZE objects are waiting the releasing thread yields until there is room
+// again (backpressure), so a burst of releases can't outrun the reclaimer without bound. Objects released
+// by destructors running on the reclaimer are queued as well (so long chains don't recurse), or destroyed
+// right away if the queue is full.
+//
+// drain_async_deletes() blocks until the queue is empty, i.e. every object queued before the call (and any
+// object their destructors queued) has been destroyed. Threads which keep releasing objects delay it.
+// async_delete_statistics() reports the queue depth, the number of objects reclaimed, how often releasing
+// threads had to wait, and how long objects waited between release and destruction.
+//
+// The reclaimer is drained and stopped when static objects are destroyed at exit; objects released after
+// that are destroyed on the releasing thread, and objects still queued when it exits on the stopping thread.
+//
+// Without C++11 <thread> this uses Boost.Thread, link with -lboost_thread -lboost_chrono.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_ASYNC_DELETE_HPP
+#define BOOST_ASYNC_DELETE_HPP
+
+#include <cstddef>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_concurrency.hpp>
+#include <boost/unique_ptr/detail/uptr_destroy.hpp>
+#include <boost/unique_ptr/detail/uptr_thread.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#if !defined(BOOST_UPTR_ASYNC_QUEUE_SIZE)
+#define BOOST_UPTR_ASYNC_QUEUE_SIZE 4096
+#endif
+
+namespace boost
+{
+    /**
+     * Snapshot of the reclaimer's counters. Latencies are measured from release to the end of destruction.
+     */
+    struct async_delete_stats
+    {
+        std::size_t queue_depth;
+        uint64_t reclaimed;
+        uint64_t backpressure_waits;
+        uint64_t total_latency_ns;
+        uint64_t max_latency_ns;
+    };
+
+    namespace uptr_detail
+    {
+        namespace async
+        {
+            const std::size_t capacity = BOOST_UPTR_ASYNC_QUEUE_SIZE;
+            BOOST_STATIC_ASSERT_MSG((capacity & (capacity - 1)) == 0, "BOOST_UPTR_ASYNC_QUEUE_SIZE must be a power of 2.");
+
+            // sequence tells producers and the consumer whose turn it is (bounded queue by Dmitry Vyukov)
+            struct slot
+            {
+                atomic<std::size_t> sequence;
+                void* ptr;
+                destroy_function destroy;
+                int64_t released;
+            };
+
+            struct reclaimer
+            {
+                reclaimer(void) :
+                    enqueue_pos(0), dequeue_pos(0), reclaimed(0), backpressure_waits(0), total_latency_ns(0),
+                    max_latency_ns(0), sleeping(false), stopped(false), joined(false), drain_waiters(0)
+                {
+                    for(std::size_t i = 0; i < capacity; ++i)
+                    {
+                        ring[i].sequence.store(i, memory_order_relaxed);
+                    }
+                }
+
+                slot ring[capacity];
+
+                char pad1[cache_line_size];
+                atomic<std::size_t> enqueue_pos;
+                char pad2[cache_line_size];
+                // only touched by the reclaimer thread
+                std::size_t dequeue_pos;
+                atomic<uint64_t> reclaimed;
+                atomic<uint64_t> backpressure_waits;
+                atomic<uint64_t> total_latency_ns;
+                atomic<uint64_t> max_latency_ns;
+
+                // the reclaimer sleeps on wake when the queue is empty, drains wait on drained
+                atomic<bool> sleeping;
+                atomic<bool> stopped;
+                // set by stop() once the reclaimer has exited, from then on the ring is emptied under lock
+                atomic<bool> joined;
+                atomic<std::size_t> drain_waiters;
+                mutex lock;
+                condition_variable wake;
+                condition_variable drained;
+                thread worker;
+            };
+
+            // statics are members of a class template so they are defined once across translation units
+            template<typename Dummy = void>
+            struct impl
+            {
+                // true on the reclaimer thread
+                static BOOST_UPTR_THREAD_LOCAL bool on_reclaimer;
+
+                // drains and stops the reclaimer when statics are destroyed, the reclaimer itself is never freed
+                struct exit_guard
+                {
+                    reclaimer* r;
+
+                    ~exit_guard(void)
+                    {
+                        impl::stop(*r);
+                    }
+                };
+
+                static reclaimer& instance(void)
+                {
+                    static reclaimer* const r = start();
+                    return *r;
+                }
+
+                static reclaimer* start(void)
+                {
+                    reclaimer* r = new reclaimer;
+                    r->worker = thread(&impl::run, r);
+                    static exit_guard guard;
+                    guard.r = r;
+                    return r;
+                }
+
+                static void retire(void* ptr, destroy_function destroy)
+                {
+                    reclaimer& r = instance();
+                    if(r.stopped.load(memory_order_acquire))
+                    {
+                        destroy(ptr);
+                        return;
+                    }
+                    const int64_t now = monotonic_ns();
+                    std::size_t pos = r.enqueue_pos.load(memory_order_relaxed);
+                    for(;;)
+                    {
+                        slot& s = r.ring[pos & (capacity - 1)];
+                        const std::size_t seq = s.sequence.load(memory_order_acquire);
+                        if(seq == pos)
+                        {
+                            if(r.enqueue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+                            {
+                                s.ptr = ptr;
+                                s.destroy = destroy;
+                                s.released = now;
+                                // seq_cst pairs with the reclaimer announcing it is about to sleep
+                                s.sequence.store(pos + 1, memory_order_seq_cst);
+                                break;
+                            }
+                        }
+                        else if(seq < pos)
+                        {
+                            if(on_reclaimer)
+                            {
+                                // the reclaimer can't wait for itself
+                                destroy(ptr);
+                                return;
+                            }
+                            // full, wait for the reclaimer to catch up
+                            r.backpressure_waits.fetch_add(1, memory_order_relaxed);
+                            notify(r);
+                            this_thread::yield();
+                            pos = r.enqueue_pos.load(memory_order_relaxed);
+                        }
+                        else
+                        {
+                            pos = r.enqueue_pos.load(memory_order_relaxed);
+                        }
+                    }
+                    // stop() may have emptied the ring for the last time before this entry was published
+                    if(r.joined.load(memory_order_seq_cst))
+                    {
+                        reclaim_stopped(r);
+                        return;
+                    }
+                    if(r.sleeping.load(memory_order_seq_cst))
+                    {
+                        notify(r);
+                    }
+                }
+
+                static void notify(reclaimer& r)
+                {
+                    unique_lock<mutex> l(r.lock);
+                    r.wake.notify_one();
+                }
+
+                // seq_cst pairs with retire() checking joined after publishing
+                static bool ready(const reclaimer& r)
+                {
+                    return r.ring[r.dequeue_pos & (capacity - 1)].sequence.load(memory_order_seq_cst) == r.dequeue_pos + 1;
+                }
+
+                static void reclaim_one(reclaimer& r)
+                {
+                    slot& s = r.ring[r.dequeue_pos & (capacity - 1)];
+                    void* const ptr = s.ptr;
+                    const destroy_function destroy = s.destroy;
+                    const int64_t released = s.released;
+                    s.sequence.store(r.dequeue_pos + capacity, memory_order_release);
+                    ++r.dequeue_pos;
+
+                    destroy(ptr);
+
+                    const int64_t elapsed = monotonic_ns() - released;
+                    const uint64_t latency = elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+                    // single writer, no read-modify-write needed
+                    r.total_latency_ns.store(r.total_latency_ns.load(memory_order_relaxed) + latency, memory_order_relaxed);
+                    if(latency > r.max_latency_ns.load(memory_order_relaxed))
+                    {
+                        r.max_latency_ns.store(latency, memory_order_relaxed);
+                    }
+                    r.reclaimed.store(r.reclaimed.load(memory_order_relaxed) + 1, memory_order_release);
+                }
+
+                static void run(reclaimer* rp)
+                {
+                    reclaimer& r = *rp;
+                    on_reclaimer = true;
+                    for(;;)
+                    {
+                        if(ready(r))
+                        {
+                            reclaim_one(r);
+                            if(r.drain_waiters.load(memory_order_acquire) != 0)
+                            {
+                                unique_lock<mutex> l(r.lock);
+                                r.drained.notify_all();
+                            }
+                            continue;
+                        }
+                        unique_lock<mutex> l(r.lock);
+                        if(r.stopped.load(memory_order_acquire) && r.dequeue_pos == r.enqueue_pos.load(memory_order_acquire))
+                        {
+                            return;
+                        }
+                        r.sleeping.store(true, memory_order_seq_cst);
+                        if(!ready(r))
+                        {
+                            r.drained.notify_all();
+                            // releases wake a sleeping reclaimer, the timeout is only a safety net
+                            r.wake.wait_for(l, chrono::milliseconds(1));
+                        }
+                        r.sleeping.store(false, memory_order_relaxed);
+                    }
+                }
+
+                static void drain(reclaimer& r)
+                {
+                    if(on_reclaimer)
+                    {
+                        return;
+                    }
+                    unique_lock<mutex> l(r.lock);
+                    r.drain_waiters.fetch_add(1, memory_order_acq_rel);
+                    r.wake.notify_one();
+                    // repeated for objects queued by the destructors of the ones waited for
+                    uint64_t target = r.enqueue_pos.load(memory_order_acquire);
+                    for(;;)
+                    {
+                        while(r.reclaimed.load(memory_order_acquire) < target)
+                        {
+                            r.drained.wait_for(l, chrono::milliseconds(1));
+                        }
+                        const uint64_t queued = r.enqueue_pos.load(memory_order_acquire);
+                        if(queued == target)
+                        {
+                            break;
+                        }
+                        target = queued;
+                    }
+                    r.drain_waiters.fetch_sub(1, memory_order_acq_rel);
+                }
+
+                static void stop(reclaimer& r)
+                {
+                    {
+                        unique_lock<mutex> l(r.lock);
+                        r.stopped.store(true, memory_order_release);
+                        r.wake.notify_one();
+                    }
+                    r.worker.join();
+                    r.joined.store(true, memory_order_seq_cst);
+                    reclaim_stopped(r);
+                }
+
+                // destroys what is left in the ring on the calling thread, after the reclaimer has exited
+                static void reclaim_stopped(reclaimer& r)
+                {
+                    unique_lock<mutex> l(r.lock);
+                    while(ready(r))
+                    {
+                        reclaim_one(r);
+                    }
+                    r.drained.notify_all();
+                }
+
+                static async_delete_stats statistics(void)
+                {
+                    reclaimer& r = instance();
+                    async_delete_stats stats;
+                    stats.reclaimed = r.reclaimed.load(memory_order_acquire);
+                    const uint64_t queued = r.enqueue_pos.load(memory_order_acquire);
+                    stats.queue_depth = queued > stats.reclaimed ? static_cast<std::size_t>(queued - stats.reclaimed) : 0;
+                    stats.backpressure_waits = r.backpressure_waits.load(memory_order_relaxed);
+                    stats.total_latency_ns = r.total_latency_ns.load(memory_order_relaxed);
+                    stats.max_latency_ns = r.max_latency_ns.load(memory_order_relaxed);
+                    return stats;
+                }
+            };
+
+            template<typename Dummy>
+            BOOST_UPTR_THREAD_LOCAL bool impl<Dummy>::on_reclaimer = false;
+        }
+    }
+
+    /**
+     * Blocks until every object queued by async_delete before the call has been destroyed, for shutdown.
+     */
+    inline void drain_async_deletes(void)
+    {
+        ::boost::uptr_detail::async::impl<>::drain(::boost::uptr_detail::async::impl<>::instance());
+    }
+
+    inline async_delete_stats async_delete_statistics(void)
+    {
+        return ::boost::uptr_detail::async::impl<>::statistics();
+    }
+
+    /**
+     * Deleter which destroys objects on the reclaimer thread.
+     */
+    template<class T>
+    struct async_delete
+    {
+    private:
+        // Used for testing if templated copy constructor can participate in overload resolution
+        struct nat
+        {
+        };
+
+    public:
+        async_delete(void)
+        {
+        }
+
+        /**
+         * Allowed iff U* is implicitly convertible to T*
+         */
+        template<class U>
+        async_delete(const async_delete<U>&, typename enable_if_c<
+                is_convertible<U*, T*>::value, nat>::type = nat())
+        {
+        }
+
+        /**
+         * Objects owned with default_delete can be handed over, both end up in delete ptr;
+         */
+        template<class U>
+        async_delete(const default_delete<U>&, typename enable_if_c<
+                is_convertible<U*, T*>::value, nat>::type = nat())
+        {
+        }
+
+        /**
+         * Queues ptr, delete ptr; runs on the reclaimer thread
+         */
+        void operator()(T* ptr) const
+        {
+            BOOST_STATIC_ASSERT_MSG(sizeof(T) > 0, "can't delete an incomplete type");
+            ::boost::uptr_detail::async::impl<>::retire(const_cast<void*>(static_cast<const volatile void*>(ptr)),
+                &::boost::uptr_detail::destroy_object<T>);
+        }
+    };
+
+    // array specialization
+    template<class T>
+    struct async_delete<T[]>
+    {
+        async_delete(void)
+        {
+        }
+
+#if defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+    private:
+        // prevents deleting an array of U
+        template<class U> void operator()(U*) const;
+    public:
+#else
+        template<class U> void operator()(U*) const = delete;
+#endif
+
+        /**
+         * Queues ptr, delete[] ptr; runs on the reclaimer thread
+         */
+        void operator()(T* ptr) const
+        {
+            BOOST_STATIC_ASSERT_MSG(sizeof(T) > 0, "can't delete an incomplete type");
+            ::boost::uptr_detail::async::impl<>::retire(const_cast<void*>(static_cast<const volatile void*>(ptr)),
+                &::boost::uptr_detail::destroy_array<T>);
+        }
+    };
+}
+
+#endif // BOOST_ASYNC_DELETE_HPP
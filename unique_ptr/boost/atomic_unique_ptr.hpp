@@ -0,0 +1,254 @@
+//
+// atomic_unique_ptr.hpp
+//
+// A unique_ptr slot shared between threads: ownership moves in and out atomically.
+//
+// atomic_unique_ptr<T, D> holds at most one object. store, exchange and take move unique_ptr<T, D> objects
+// in and out, compare_exchange_strong/weak swap ownership only if the slot still holds the expected object:
+//
+//  boost::atomic_unique_ptr<buffer> mailbox;
+//  mailbox.store(boost::make_unique<buffer>());    // producer, deletes a buffer nobody picked up
+//  boost::unique_ptr<buffer> b = mailbox.take();   // consumer, b is empty if there was nothing
+//
+// With an empty (stateless) deleter and a raw pointer type the slot is a single atomic pointer and every
+// operation is lock-free. Otherwise the pointer and deleter are exchanged together under a spin lock.
+//
+// Like std::atomic it can be neither copied nor moved.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_ATOMIC_UNIQUE_PTR_HPP
+#define BOOST_ATOMIC_UNIQUE_PTR_HPP
+
+#include <boost/config.hpp>
+#include <boost/type_traits/is_empty.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_compressed_pair.hpp>
+#include <boost/unique_ptr/detail/uptr_concurrency.hpp>
+#include <boost/unique_ptr/detail/uptr_reject_lvalue.hpp>
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        template<class T, class D, bool LockFree>
+        class atomic_uptr_storage;
+
+        // stateless deleter: the slot is just the pointer
+        template<class T, class D>
+        class atomic_uptr_storage<T, D, true>
+        {
+        public:
+            typedef unique_ptr<T, D> value_type;
+            typedef typename value_type::pointer pointer;
+
+            BOOST_STATIC_CONSTANT(bool, lock_free = true);
+
+            atomic_uptr_storage(void)
+            {
+                storage.first().store(pointer(), memory_order_relaxed);
+            }
+
+            ~atomic_uptr_storage(void)
+            {
+                const pointer p = storage.first().load(memory_order_acquire);
+                if(p != pointer())
+                {
+                    storage.second()(p);
+                }
+            }
+
+            pointer load(void) const
+            {
+                return storage.first().load(memory_order_acquire);
+            }
+
+            value_type exchange(value_type& u)
+            {
+                return value_type(storage.first().exchange(u.release(), memory_order_acq_rel));
+            }
+
+            bool compare_exchange(pointer& expected, value_type& desired, bool weak)
+            {
+                atomic<pointer>& p = storage.first();
+                const pointer d = desired.get();
+                if(weak ? p.compare_exchange_weak(expected, d, memory_order_acq_rel, memory_order_acquire)
+                    : p.compare_exchange_strong(expected, d, memory_order_acq_rel, memory_order_acquire))
+                {
+                    desired.release();
+                    desired.reset(expected);
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            compressed_pair<atomic<pointer>, D> storage;
+        };
+
+        // stateful deleter (or fancy pointer): pointer and deleter change together under a spin lock
+        template<class T, class D>
+        class atomic_uptr_storage<T, D, false>
+        {
+        public:
+            typedef unique_ptr<T, D> value_type;
+            typedef typename value_type::pointer pointer;
+
+            BOOST_STATIC_CONSTANT(bool, lock_free = false);
+
+            atomic_uptr_storage(void) :
+                locked(false)
+            {
+            }
+
+            pointer load(void) const
+            {
+                lock();
+                const pointer p = owner.get();
+                unlock();
+                return p;
+            }
+
+            value_type exchange(value_type& u)
+            {
+                lock();
+                owner.swap(u);
+                unlock();
+                return boost::move(u);
+            }
+
+            bool compare_exchange(pointer& expected, value_type& desired, bool)
+            {
+                lock();
+                if(owner.get() == expected)
+                {
+                    owner.swap(desired);
+                    unlock();
+                    return true;
+                }
+                expected = owner.get();
+                unlock();
+                return false;
+            }
+
+        private:
+            void lock(void) const
+            {
+                while(locked.exchange(true, memory_order_acquire))
+                {
+                    while(locked.load(memory_order_relaxed))
+                    {
+                    }
+                }
+            }
+
+            void unlock(void) const
+            {
+                locked.store(false, memory_order_release);
+            }
+
+            mutable atomic<bool> locked;
+            value_type owner;
+        };
+    }
+
+    template<class T, class D = default_delete<T> >
+    class atomic_unique_ptr
+    {
+        typedef ::boost::uptr_detail::atomic_uptr_storage<T, D,
+            is_empty<D>::value && is_pointer<typename unique_ptr<T, D>::pointer>::value> storage_type;
+
+        // not copyable or movable
+        atomic_unique_ptr(const atomic_unique_ptr&);
+        atomic_unique_ptr& operator=(const atomic_unique_ptr&);
+
+    public:
+        typedef unique_ptr<T, D> value_type;
+        typedef typename value_type::pointer pointer;
+        typedef typename value_type::element_type element_type;
+        typedef D deleter_type;
+
+        BOOST_STATIC_CONSTANT(bool, is_always_lock_free = storage_type::lock_free);
+
+        atomic_unique_ptr(void)
+        {
+        }
+
+        /**
+         * Takes ownership of u's object.
+         */
+        explicit atomic_unique_ptr(BOOST_RV_REF(value_type) u)
+        {
+            store(boost::move(static_cast<value_type&>(u)));
+        }
+
+        bool is_lock_free(void) const
+        {
+            return is_always_lock_free;
+        }
+
+        /**
+         * The object currently owned. Only an observation: another thread may take and delete it right after.
+         */
+        pointer load(void) const
+        {
+            return storage.load();
+        }
+
+        /**
+         * Takes ownership of u's object and deletes the previously owned object.
+         */
+        void store(BOOST_RV_REF(value_type) u)
+        {
+            value_type old(storage.exchange(static_cast<value_type&>(u)));
+        }
+
+        /**
+         * Takes ownership of u's object and returns the previously owned object.
+         */
+        value_type exchange(BOOST_RV_REF(value_type) u)
+        {
+            return storage.exchange(static_cast<value_type&>(u));
+        }
+
+        /**
+         * Returns the owned object, leaving this empty.
+         */
+        value_type take(void)
+        {
+            value_type empty;
+            return storage.exchange(empty);
+        }
+
+        /**
+         * If the owned object is expected, swaps ownership with desired: this takes desired's object
+         * and desired receives the previously owned one. Otherwise expected is set to the owned object.
+         */
+        bool compare_exchange_strong(pointer& expected, value_type& desired)
+        {
+            return storage.compare_exchange(expected, desired, false);
+        }
+
+        /**
+         * Same as compare_exchange_strong, but may fail spuriously.
+         */
+        bool compare_exchange_weak(pointer& expected, value_type& desired)
+        {
+            return storage.compare_exchange(expected, desired, true);
+        }
+
+    private:
+        explicit atomic_unique_ptr(value_type&) BOOST_UPTR_REJECT_LVALUE;
+        void store(value_type&) BOOST_UPTR_REJECT_LVALUE;
+        value_type exchange(value_type&) BOOST_UPTR_REJECT_LVALUE;
+
+        storage_type storage;
+    };
+}
+
+#endif // BOOST_ATOMIC_UNIQUE_PTR_HPP
@@ -0,0 +1,378 @@
+//
+// channel.hpp
+//
+// Bounded lock-free channels which move unique_ptr ownership between threads.
+//
+//  spsc_channel<unique_ptr<T, D> >  one producer thread, one consumer thread
+//  mpmc_channel<unique_ptr<T, D> >  any number of producers and consumers
+//
+// Only raw pointers are stored, the deleter is kept once per channel (compressed away when empty) and
+// given to every popped unique_ptr, so per-object deleter state doesn't travel through a channel.
+//
+// push(boost::move(p)) moves p in and returns true, or returns false and leaves p alone if the channel is
+// full. pop(p) moves the oldest object into p and returns true, or returns false if the channel is empty.
+// push_n and pop_n move up to n objects at once with a single index update, returning how many moved.
+// Objects still queued when a channel is destroyed are deleted.
+//
+// The capacity is rounded up to a power of 2.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_CHANNEL_HPP
+#define BOOST_CHANNEL_HPP
+
+#include <cstddef>
+#include <new>
+#include <boost/config.hpp>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_compressed_pair.hpp>
+#include <boost/unique_ptr/detail/uptr_concurrency.hpp>
+#include <boost/unique_ptr/detail/uptr_reject_lvalue.hpp>
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        inline std::size_t channel_capacity(std::size_t requested)
+        {
+            std::size_t capacity = 1;
+            while(capacity < requested)
+            {
+                capacity *= 2;
+                if(capacity == 0)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+            return capacity;
+        }
+    }
+
+    template<class Ptr>
+    class spsc_channel;
+
+    template<class Ptr>
+    class mpmc_channel;
+
+    template<class T, class D>
+    class spsc_channel<unique_ptr<T, D> >
+    {
+        // not copyable or movable
+        spsc_channel(const spsc_channel&);
+        spsc_channel& operator=(const spsc_channel&);
+
+    public:
+        typedef unique_ptr<T, D> value_type;
+        typedef typename value_type::pointer pointer;
+        typedef D deleter_type;
+
+        explicit spsc_channel(std::size_t capacity, const D& d = D()) :
+            storage(new pointer[::boost::uptr_detail::channel_capacity(capacity)], d),
+            mask(::boost::uptr_detail::channel_capacity(capacity) - 1), tail(0), cached_head(0), head(0), cached_tail(0)
+        {
+        }
+
+        ~spsc_channel(void)
+        {
+            const std::size_t t = tail.load(::boost::uptr_detail::memory_order_acquire);
+            for(std::size_t h = head.load(::boost::uptr_detail::memory_order_relaxed); h != t; ++h)
+            {
+                if(storage.first()[h & mask] != pointer())
+                {
+                    storage.second()(storage.first()[h & mask]);
+                }
+            }
+            delete[] storage.first();
+        }
+
+        std::size_t capacity(void) const
+        {
+            return mask + 1;
+        }
+
+        /**
+         * Number of queued objects, only exact when neither end is in use.
+         */
+        std::size_t size(void) const
+        {
+            return tail.load(::boost::uptr_detail::memory_order_acquire) - head.load(::boost::uptr_detail::memory_order_acquire);
+        }
+
+        bool empty(void) const
+        {
+            return size() == 0;
+        }
+
+        const D& get_deleter(void) const
+        {
+            return storage.second();
+        }
+
+        /**
+         * Producer only. Moves u in, returns false (u keeps its object) if the channel is full.
+         */
+        bool push(BOOST_RV_REF(value_type) u)
+        {
+            return push_n(&static_cast<value_type&>(u), 1) == 1;
+        }
+
+        /**
+         * Producer only. Moves up to n objects from first, first + 1, ... in, returns how many moved.
+         */
+        std::size_t push_n(value_type* first, std::size_t n)
+        {
+            const std::size_t t = tail.load(::boost::uptr_detail::memory_order_relaxed);
+            std::size_t room = capacity() - (t - cached_head);
+            if(room < n)
+            {
+                cached_head = head.load(::boost::uptr_detail::memory_order_acquire);
+                room = capacity() - (t - cached_head);
+            }
+            const std::size_t m = n < room ? n : room;
+            for(std::size_t i = 0; i < m; ++i)
+            {
+                storage.first()[(t + i) & mask] = first[i].release();
+            }
+            tail.store(t + m, ::boost::uptr_detail::memory_order_release);
+            return m;
+        }
+
+        /**
+         * Consumer only. Moves the oldest object into u, returns false if the channel is empty.
+         */
+        bool pop(value_type& u)
+        {
+            return pop_n(&u, 1) == 1;
+        }
+
+        /**
+         * Consumer only. Moves up to n objects into first, first + 1, ..., returns how many moved.
+         */
+        std::size_t pop_n(value_type* first, std::size_t n)
+        {
+            const std::size_t h = head.load(::boost::uptr_detail::memory_order_relaxed);
+            std::size_t ready = cached_tail - h;
+            if(ready < n)
+            {
+                cached_tail = tail.load(::boost::uptr_detail::memory_order_acquire);
+                ready = cached_tail - h;
+            }
+            const std::size_t m = n < ready ? n : ready;
+            for(std::size_t i = 0; i < m; ++i)
+            {
+                first[i] = value_type(storage.first()[(h + i) & mask], storage.second());
+            }
+            head.store(h + m, ::boost::uptr_detail::memory_order_release);
+            return m;
+        }
+
+    private:
+        bool push(value_type&) BOOST_UPTR_REJECT_LVALUE;
+
+        ::boost::uptr_detail::compressed_pair<pointer*, D> storage;
+        const std::size_t mask;
+
+        // producer side: tail and the last head it saw
+        char pad1[::boost::uptr_detail::cache_line_size];
+        ::boost::uptr_detail::atomic<std::size_t> tail;
+        std::size_t cached_head;
+
+        // consumer side: head and the last tail it saw
+        char pad2[::boost::uptr_detail::cache_line_size];
+        ::boost::uptr_detail::atomic<std::size_t> head;
+        std::size_t cached_tail;
+        char pad3[::boost::uptr_detail::cache_line_size];
+    };
+
+    template<class T, class D>
+    class mpmc_channel<unique_ptr<T, D> >
+    {
+        // not copyable or movable
+        mpmc_channel(const mpmc_channel&);
+        mpmc_channel& operator=(const mpmc_channel&);
+
+    public:
+        typedef unique_ptr<T, D> value_type;
+        typedef typename value_type::pointer pointer;
+        typedef D deleter_type;
+
+    private:
+        // sequence tells producers and consumers whose turn it is (bounded queue by Dmitry Vyukov)
+        struct slot
+        {
+            ::boost::uptr_detail::atomic<std::size_t> sequence;
+            pointer p;
+        };
+
+    public:
+        explicit mpmc_channel(std::size_t capacity, const D& d = D()) :
+            storage(0, d), mask(::boost::uptr_detail::channel_capacity(capacity) - 1), enqueue_pos(0), dequeue_pos(0)
+        {
+            storage.first() = static_cast<slot*>(::operator new((mask + 1) * sizeof(slot)));
+            for(std::size_t i = 0; i <= mask; ++i)
+            {
+                new (&storage.first()[i]) slot();
+                storage.first()[i].sequence.store(i, ::boost::uptr_detail::memory_order_relaxed);
+            }
+        }
+
+        ~mpmc_channel(void)
+        {
+            value_type u;
+            while(pop(u))
+            {
+            }
+            u.reset();
+            for(std::size_t i = 0; i <= mask; ++i)
+            {
+                storage.first()[i].~slot();
+            }
+            ::operator delete(storage.first());
+        }
+
+        std::size_t capacity(void) const
+        {
+            return mask + 1;
+        }
+
+        /**
+         * Number of queued objects (including ones being pushed or popped right now).
+         */
+        std::size_t size(void) const
+        {
+            const std::size_t h = dequeue_pos.load(::boost::uptr_detail::memory_order_acquire);
+            const std::size_t t = enqueue_pos.load(::boost::uptr_detail::memory_order_acquire);
+            return t > h ? t - h : 0;
+        }
+
+        bool empty(void) const
+        {
+            return size() == 0;
+        }
+
+        const D& get_deleter(void) const
+        {
+            return storage.second();
+        }
+
+        /**
+         * Moves u in, returns false (u keeps its object) if the channel is full.
+         */
+        bool push(BOOST_RV_REF(value_type) u)
+        {
+            return push_n(&static_cast<value_type&>(u), 1) == 1;
+        }
+
+        /**
+         * Moves up to n objects from first, first + 1, ... in, returns how many moved.
+         * The objects are claimed as one block, so they stay adjacent in the channel.
+         */
+        std::size_t push_n(value_type* first, std::size_t n)
+        {
+            slot* const ring = storage.first();
+            std::size_t pos = enqueue_pos.load(::boost::uptr_detail::memory_order_relaxed);
+            std::size_t m;
+            for(;;)
+            {
+                // slots after pos only become free in order for this lap, so count the free run
+                m = 0;
+                while(m < n && m <= mask
+                    && ring[(pos + m) & mask].sequence.load(::boost::uptr_detail::memory_order_acquire) == pos + m)
+                {
+                    ++m;
+                }
+                if(m == 0)
+                {
+                    const std::size_t seq = ring[pos & mask].sequence.load(::boost::uptr_detail::memory_order_acquire);
+                    if(seq < pos)
+                    {
+                        // full
+                        return 0;
+                    }
+                    pos = enqueue_pos.load(::boost::uptr_detail::memory_order_relaxed);
+                    continue;
+                }
+                if(enqueue_pos.compare_exchange_weak(pos, pos + m, ::boost::uptr_detail::memory_order_relaxed,
+                    ::boost::uptr_detail::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            for(std::size_t i = 0; i < m; ++i)
+            {
+                slot& s = ring[(pos + i) & mask];
+                s.p = first[i].release();
+                s.sequence.store(pos + i + 1, ::boost::uptr_detail::memory_order_release);
+            }
+            return m;
+        }
+
+        /**
+         * Moves the oldest object into u, returns false if the channel is empty.
+         */
+        bool pop(value_type& u)
+        {
+            return pop_n(&u, 1) == 1;
+        }
+
+        /**
+         * Moves up to n objects into first, first + 1, ..., returns how many moved.
+         */
+        std::size_t pop_n(value_type* first, std::size_t n)
+        {
+            slot* const ring = storage.first();
+            std::size_t pos = dequeue_pos.load(::boost::uptr_detail::memory_order_relaxed);
+            std::size_t m;
+            for(;;)
+            {
+                m = 0;
+                while(m < n && m <= mask
+                    && ring[(pos + m) & mask].sequence.load(::boost::uptr_detail::memory_order_acquire) == pos + m + 1)
+                {
+                    ++m;
+                }
+                if(m == 0)
+                {
+                    const std::size_t seq = ring[pos & mask].sequence.load(::boost::uptr_detail::memory_order_acquire);
+                    if(seq < pos + 1)
+                    {
+                        // empty (or the next object is still being pushed)
+                        return 0;
+                    }
+                    pos = dequeue_pos.load(::boost::uptr_detail::memory_order_relaxed);
+                    continue;
+                }
+                if(dequeue_pos.compare_exchange_weak(pos, pos + m, ::boost::uptr_detail::memory_order_relaxed,
+                    ::boost::uptr_detail::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            for(std::size_t i = 0; i < m; ++i)
+            {
+                slot& s = ring[(pos + i) & mask];
+                first[i] = value_type(s.p, storage.second());
+                s.sequence.store(pos + i + mask + 1, ::boost::uptr_detail::memory_order_release);
+            }
+            return m;
+        }
+
+    private:
+        bool push(value_type&) BOOST_UPTR_REJECT_LVALUE;
+
+        ::boost::uptr_detail::compressed_pair<slot*, D> storage;
+        const std::size_t mask;
+
+        char pad1[::boost::uptr_detail::cache_line_size];
+        ::boost::uptr_detail::atomic<std::size_t> enqueue_pos;
+        char pad2[::boost::uptr_detail::cache_line_size];
+        ::boost::uptr_detail::atomic<std::size_t> dequeue_pos;
+        char pad3[::boost::uptr_detail::cache_line_size];
+    };
+}
+
+#endif // BOOST_CHANNEL_HPP
@@ -0,0 +1,320 @@
+//
+// compact_ptr.hpp
+//
+// 32-bit owning pointers for objects living in one large arena.
+//
+// compact_arena<Shift, Tag> reserves a contiguous region (up to 2^(32 + Shift) bytes, 32 GB with the default
+// Shift of 3) and bump-allocates from it with at least 2^Shift byte alignment. compact_ptr<T, Arena> stores
+// the offset of an object from the region's base divided by 2^Shift in 32 bits; 0 is the null pointer.
+//
+// compact_delete<T, Arena> declares compact_ptr<T, Arena> as its pointer type, so through the custom pointer
+// hook unique_ptr<T, compact_delete<T, Arena> > owns an object in half the space of a regular unique_ptr.
+// make_unique_compact<T>(arena, args...) creates one:
+//
+//  typedef boost::compact_arena<> arena_type;
+//  struct node { boost::unique_ptr<node, boost::compact_delete<node, arena_type> > left, right; int key; };
+//  arena_type arena(std::size_t(1) << 30);
+//  boost::unique_ptr<node, boost::compact_delete<node, arena_type> > root = boost::make_unique_compact<node>(arena);
+//
+// The base is a static member of the arena type, so only one arena of each compact_arena<Shift, Tag> type
+// can exist at a time; use different Tag types for independent arenas. Like monotonic_arena, compact_delete
+// only runs the destructor and the memory is reclaimed by reset() or when the arena is destroyed.
+// On POSIX the region is reserved with mmap(MAP_NORESERVE), so only touched pages use memory.
+//
+// compact_arena is not thread safe, compact_ptr can be used from any thread while the arena exists.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_COMPACT_PTR_HPP
+#define BOOST_COMPACT_PTR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/make_unique.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <sys/mman.h>
+#endif
+
+namespace boost
+{
+    template<std::size_t Shift = 3, class Tag = void>
+    class compact_arena : private noncopyable
+    {
+        BOOST_STATIC_ASSERT_MSG(Shift < 16, "Shift is too large.");
+
+    public:
+        BOOST_STATIC_CONSTANT(std::size_t, shift = Shift);
+        BOOST_STATIC_CONSTANT(std::size_t, granularity = std::size_t(1) << Shift);
+
+        /**
+         * Reserves capacity bytes, at most max_capacity(). Throws std::bad_alloc on failure.
+         */
+        explicit compact_arena(std::size_t capacity) :
+            size(capacity < max_capacity() ? capacity : static_cast<std::size_t>(max_capacity())), cur(granularity)
+        {
+            BOOST_ASSERT_MSG(region == 0, "only one compact_arena of each type can exist at a time");
+#if defined(BOOST_HAS_UNISTD_H)
+            void* p = ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if(p == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+#else
+            void* p = std::malloc(size);
+            if(p == 0)
+            {
+                throw std::bad_alloc();
+            }
+#endif
+            region = static_cast<char*>(p);
+        }
+
+        ~compact_arena(void)
+        {
+#if defined(BOOST_HAS_UNISTD_H)
+            ::munmap(region, size);
+#else
+            std::free(region);
+#endif
+            region = 0;
+        }
+
+        /**
+         * Largest region whose offsets fit in 32 bits.
+         */
+        static uint64_t max_capacity(void)
+        {
+            return uint64_t(1) << (32 + Shift);
+        }
+
+        /**
+         * Returns size bytes aligned to align (a power of 2) and at least granularity.
+         * Throws std::bad_alloc when the region is full.
+         */
+        void* allocate(std::size_t bytes, std::size_t align)
+        {
+            if(align < granularity)
+            {
+                align = granularity;
+            }
+            const std::size_t p = (cur + align - 1) & ~(align - 1);
+            if(p > size || bytes > size - p)
+            {
+                throw std::bad_alloc();
+            }
+            cur = p + bytes;
+            return region + p;
+        }
+
+        /**
+         * Rewinds the arena. The pages stay reserved.
+         */
+        void reset(void)
+        {
+            cur = granularity;
+        }
+
+        std::size_t capacity(void) const
+        {
+            return size;
+        }
+
+        /**
+         * Bytes allocated so far (including alignment padding).
+         */
+        std::size_t used(void) const
+        {
+            return cur - granularity;
+        }
+
+        /**
+         * Offset of p (which must point into the region, or be null) in units of granularity.
+         */
+        static uint32_t compress(const void* p)
+        {
+            return p != 0 ? static_cast<uint32_t>(static_cast<std::size_t>(static_cast<const char*>(p) - region) >> Shift) : 0;
+        }
+
+        static void* decompress(uint32_t offset)
+        {
+            return offset != 0 ? region + (static_cast<std::size_t>(offset) << Shift) : 0;
+        }
+
+    private:
+        static char* region;
+
+        std::size_t size;
+        // offset 0 is reserved for null
+        std::size_t cur;
+    };
+
+    template<std::size_t Shift, class Tag>
+    char* compact_arena<Shift, Tag>::region = 0;
+
+    /**
+     * Nullable 32-bit pointer into an Arena, used as compact_delete::pointer.
+     * Null (value-initialized or constructed from nullptr/NULL) has offset 0.
+     */
+    template<class T, class Arena>
+    class compact_ptr
+    {
+        struct nat
+        {
+            int dummy;
+        };
+
+    public:
+        typedef T element_type;
+
+        compact_ptr(void) :
+            bits()
+        {
+        }
+
+        /**
+         * Null pointer, accepts nullptr and NULL
+         */
+        compact_ptr(int nat::*) :
+            bits()
+        {
+        }
+
+        /**
+         * p must point into the region of the live Arena.
+         */
+        explicit compact_ptr(T* p) :
+            bits(Arena::compress(p))
+        {
+        }
+
+        T* get(void) const
+        {
+            return static_cast<T*>(Arena::decompress(bits));
+        }
+
+        uint32_t offset(void) const
+        {
+            return bits;
+        }
+
+        T& operator*(void) const
+        {
+            return *get();
+        }
+
+        T* operator->(void) const
+        {
+            return get();
+        }
+
+#if !defined(BOOST_NO_CXX11_EXPLICIT_CONVERSION_OPERATORS)
+        // some standard library implementations test pointers with if(p)
+        // (no safe bool for C++03, it would make comparisons with NULL ambiguous)
+        explicit operator bool(void) const
+        {
+            return bits != 0;
+        }
+#endif
+
+        friend bool operator==(const compact_ptr& a, const compact_ptr& b)
+        {
+            return a.bits == b.bits;
+        }
+
+        friend bool operator!=(const compact_ptr& a, const compact_ptr& b)
+        {
+            return a.bits != b.bits;
+        }
+
+        // offsets are ordered like the addresses
+        friend bool operator<(const compact_ptr& a, const compact_ptr& b)
+        {
+            return a.bits < b.bits;
+        }
+
+    private:
+        uint32_t bits;
+    };
+
+    /**
+     * Deleter for objects created by make_unique_compact. Only runs the destructor, the memory belongs to the arena.
+     */
+    template<class T, class Arena>
+    struct compact_delete
+    {
+        typedef compact_ptr<T, Arena> pointer;
+
+        /**
+         * Equivalent to: ptr->~T();
+         */
+        void operator()(pointer ptr) const
+        {
+            ptr->~T();
+        }
+    };
+
+    namespace uptr_detail
+    {
+        template<typename T, class Arena>
+        struct make_unique_compact_switch
+        {
+            typedef ::boost::unique_ptr<T, ::boost::compact_delete<T, Arena> > single_object;
+        };
+
+        // arrays aren't supported
+        template<typename T, class Arena>
+        struct make_unique_compact_switch<T[], Arena>
+        {
+        };
+
+        template<typename T, std::size_t N, class Arena>
+        struct make_unique_compact_switch<T[N], Arena>
+        {
+        };
+    }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    /**
+     * Equivalent to: unique_ptr<T, compact_delete<T, Arena> >(compact_ptr<T, Arena>(new (arena) T(std::forward<Args>(args)...)));
+     */
+    template<typename T, std::size_t Shift, class Tag, typename... Args>
+    inline typename ::boost::uptr_detail::make_unique_compact_switch<T, compact_arena<Shift, Tag> >::single_object
+    make_unique_compact(compact_arena<Shift, Tag>& arena, Args&&... args)
+    {
+        void* mem = arena.allocate(sizeof(T), alignment_of<T>::value);
+        return typename ::boost::uptr_detail::make_unique_compact_switch<T, compact_arena<Shift, Tag> >::single_object(
+            compact_ptr<T, compact_arena<Shift, Tag> >(new (mem) T(::boost::uptr_detail::forward<Args>(args)...)));
+    }
+#else
+    /**
+     * Equivalent to: unique_ptr<T, compact_delete<T, Arena> >(compact_ptr<T, Arena>(new (arena) T(a0, ..., an-1)));
+     */
+#define BOOST_UPTR_MAKE_UNIQUE_COMPACT(z, n, data) \
+    template<typename T, std::size_t Shift, class Tag BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+    inline typename ::boost::uptr_detail::make_unique_compact_switch<T, compact_arena<Shift, Tag> >::single_object \
+    make_unique_compact(compact_arena<Shift, Tag>& arena BOOST_UPTR_FWD_TRAILING_PARAMS(n)) \
+    { \
+        void* mem = arena.allocate(sizeof(T), alignment_of<T>::value); \
+        return typename ::boost::uptr_detail::make_unique_compact_switch<T, compact_arena<Shift, Tag> >::single_object( \
+            compact_ptr<T, compact_arena<Shift, Tag> >(new (mem) T(BOOST_UPTR_FWD_ARGS(n)))); \
+    }
+
+    BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_MAKE_UNIQUE_COMPACT, ~)
+
+#undef BOOST_UPTR_MAKE_UNIQUE_COMPACT
+#endif
+}
+
+#endif // BOOST_COMPACT_PTR_HPP
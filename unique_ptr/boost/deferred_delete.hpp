@@ -0,0 +1,267 @@
+//
+// deferred_delete.hpp
+//
+// Moves destruction off latency critical paths.
+//
+// deferred_delete<T> doesn't delete anything when the owning unique_ptr lets go of its object. It appends
+// the pointer and a type-erased destroy function to a batch owned by the calling thread. The batch is
+// destroyed at the next flush_deferred() on that thread, e.g. between requests:
+//
+//  boost::unique_ptr<node, boost::deferred_delete<node> > graph(new node);
+//  ...
+//  graph.reset();              // cheap: only queues the pointer
+//  ...
+//  boost::flush_deferred();    // deletes everything queued by this thread
+//
+// A full batch (BOOST_UPTR_DEFERRED_BATCH_SIZE entries) is flushed by the deleter itself, which bounds the
+// memory held back. A flush sorts the batch by destroy function so objects of the same type are destroyed
+// together. Objects deferred by destructors running in a flush are destroyed by the same flush. If a destructor
+// throws, the flush stops and rethrows, the objects it didn't get to stay queued for the next flush.
+//
+// The batch is destroyed on thread exit when thread_local is available. Without C++11 thread_local there is
+// no thread exit hook: call flush_deferred() before a thread using deferred_delete exits.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_DEFERRED_DELETE_HPP
+#define BOOST_DEFERRED_DELETE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_concurrency.hpp>
+#include <boost/unique_ptr/detail/uptr_destroy.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#if !defined(BOOST_UPTR_DEFERRED_BATCH_SIZE)
+#define BOOST_UPTR_DEFERRED_BATCH_SIZE 256
+#endif
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        namespace deferred
+        {
+            struct entry
+            {
+                void* ptr;
+                destroy_function destroy;
+            };
+
+            const std::size_t capacity = BOOST_UPTR_DEFERRED_BATCH_SIZE;
+
+            // POD so it can live in C++03 thread local storage
+            struct batch
+            {
+                entry entries[capacity];
+                std::size_t count;
+                // entries of the running flush not destroyed yet, their slots are kept free so they can be
+                // put back if a destructor throws
+                std::size_t held;
+                bool flushing;
+            };
+
+            inline bool by_type(const entry& a, const entry& b)
+            {
+                return std::less<destroy_function>()(a.destroy, b.destroy);
+            }
+
+            // statics are members of a class template so they are defined once across translation units
+            template<typename Dummy = void>
+            struct impl
+            {
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+                // destroys whatever is left on thread exit
+                struct batch_handle
+                {
+                    batch pending;
+
+                    ~batch_handle(void)
+                    {
+                        impl::flush();
+                    }
+                };
+                static thread_local batch_handle local;
+#else
+                struct batch_handle
+                {
+                    batch pending;
+                };
+                static BOOST_UPTR_THREAD_LOCAL batch_handle local;
+#endif
+
+                static void defer(void* ptr, destroy_function destroy)
+                {
+                    batch& b = local.pending;
+                    if(b.count + b.held == capacity)
+                    {
+                        if(b.flushing)
+                        {
+                            // a destructor in the running flush deferred more than fits, don't recurse
+                            destroy(ptr);
+                            return;
+                        }
+                        flush();
+                    }
+                    entry& e = b.entries[b.count++];
+                    e.ptr = ptr;
+                    e.destroy = destroy;
+                }
+
+                static void flush(void)
+                {
+                    batch& b = local.pending;
+                    if(b.flushing)
+                    {
+                        return;
+                    }
+                    b.flushing = true;
+                    // destructors may defer more objects, those are picked up by the next round
+                    entry work[capacity];
+                    while(b.count != 0)
+                    {
+                        const std::size_t n = b.count;
+                        std::copy(b.entries, b.entries + n, work);
+                        b.count = 0;
+                        std::sort(work, work + n, by_type);
+                        std::size_t i = 0;
+                        try
+                        {
+                            for(; i < n; ++i)
+                            {
+                                b.held = n - i - 1;
+                                work[i].destroy(work[i].ptr);
+                            }
+                        }
+                        catch(...)
+                        {
+                            // the rest waits for the next flush, ahead of what was deferred meanwhile
+                            std::copy_backward(b.entries, b.entries + b.count, b.entries + b.count + b.held);
+                            std::copy(work + i + 1, work + n, b.entries);
+                            b.count += b.held;
+                            b.held = 0;
+                            b.flushing = false;
+                            throw;
+                        }
+                    }
+                    b.held = 0;
+                    b.flushing = false;
+                }
+
+                static std::size_t pending(void)
+                {
+                    return local.pending.count;
+                }
+            };
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            template<typename Dummy>
+            thread_local typename impl<Dummy>::batch_handle impl<Dummy>::local;
+#else
+            template<typename Dummy>
+            BOOST_UPTR_THREAD_LOCAL typename impl<Dummy>::batch_handle impl<Dummy>::local;
+#endif
+        }
+    }
+
+    /**
+     * Destroys every object this thread deferred, grouped by type.
+     */
+    inline void flush_deferred(void)
+    {
+        ::boost::uptr_detail::deferred::impl<>::flush();
+    }
+
+    /**
+     * Number of objects this thread deferred which haven't been destroyed yet.
+     */
+    inline std::size_t deferred_pending(void)
+    {
+        return ::boost::uptr_detail::deferred::impl<>::pending();
+    }
+
+    /**
+     * Deleter which queues objects for destruction at the next flush_deferred() on the calling thread.
+     */
+    template<class T>
+    struct deferred_delete
+    {
+    private:
+        // Used for testing if templated copy constructor can participate in overload resolution
+        struct nat
+        {
+        };
+
+    public:
+        deferred_delete(void)
+        {
+        }
+
+        /**
+         * Allowed iff U* is implicitly convertible to T*
+         */
+        template<class U>
+        deferred_delete(const deferred_delete<U>&, typename enable_if_c<
+                is_convertible<U*, T*>::value, nat>::type = nat())
+        {
+        }
+
+        /**
+         * Objects owned with default_delete can be handed over, both end up in delete ptr;
+         */
+        template<class U>
+        deferred_delete(const default_delete<U>&, typename enable_if_c<
+                is_convertible<U*, T*>::value, nat>::type = nat())
+        {
+        }
+
+        /**
+         * Queues ptr, delete ptr; runs at the next flush_deferred()
+         */
+        void operator()(T* ptr) const
+        {
+            BOOST_STATIC_ASSERT_MSG(sizeof(T) > 0, "can't delete an incomplete type");
+            ::boost::uptr_detail::deferred::impl<>::defer(const_cast<void*>(static_cast<const volatile void*>(ptr)),
+                &::boost::uptr_detail::destroy_object<T>);
+        }
+    };
+
+    // array specialization
+    template<class T>
+    struct deferred_delete<T[]>
+    {
+        deferred_delete(void)
+        {
+        }
+
+#if defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+    private:
+        // prevents deleting an array of U
+        template<class U> void operator()(U*) const;
+    public:
+#else
+        template<class U> void operator()(U*) const = delete;
+#endif
+
+        /**
+         * Queues ptr, delete[] ptr; runs at the next flush_deferred()
+         */
+        void operator()(T* ptr) const
+        {
+            BOOST_STATIC_ASSERT_MSG(sizeof(T) > 0, "can't delete an incomplete type");
+            ::boost::uptr_detail::deferred::impl<>::defer(const_cast<void*>(static_cast<const volatile void*>(ptr)),
+                &::boost::uptr_detail::destroy_array<T>);
+        }
+    };
+}
+
+#endif // BOOST_DEFERRED_DELETE_HPP
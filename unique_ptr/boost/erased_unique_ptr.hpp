@@ -0,0 +1,226 @@
+//
+// erased_unique_ptr.hpp
+//
+// Owning pointer to an object of any type, destroyed as its exact type.
+//
+// erased_unique_ptr is a unique_ptr<void, erased_delete>. erased_delete holds a single pointer to a destroy
+// function chosen when the object is created, so objects of unrelated types can share one container and
+// each is deleted as the type it was created with, without a virtual destructor:
+//
+//  boost::erased_unique_ptr plugins[2];
+//  plugins[0] = boost::make_erased<codec>(config);
+//  plugins[1].reset(new muxer(config));           // deleted as muxer
+//  codec* c = static_cast<codec*>(plugins[0].get());
+//
+// An erased_unique_ptr is two pointers wide. Being derived from unique_ptr it compares with the operators of
+// uptr_comparison.hpp (against other unique_ptrs and nullptr). Its constructor and reset() only take typed
+// pointers and set the destroy function for the pointer's static type, so a T* is deleted as T (T's
+// destructor should be virtual if the object is a derived type). A unique_ptr<T> converts to it the same way.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_ERASED_UNIQUE_PTR_HPP
+#define BOOST_ERASED_UNIQUE_PTR_HPP
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/move/move.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_array.hpp>
+#include <boost/type_traits/is_void.hpp>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_destroy.hpp>
+#include <boost/unique_ptr/detail/uptr_factory.hpp>
+#include <boost/utility/enable_if.hpp>
+
+namespace boost
+{
+    struct erased_delete
+    {
+    private:
+        // Used for testing if templated copy constructor can participate in overload resolution
+        struct nat
+        {
+        };
+
+    public:
+        erased_delete(void) :
+            destroy()
+        {
+        }
+
+        explicit erased_delete(::boost::uptr_detail::destroy_function destroy) :
+            destroy(destroy)
+        {
+        }
+
+        /**
+         * Deletes as U, so unique_ptr<U> converts to erased_unique_ptr
+         */
+        template<class U>
+        erased_delete(const default_delete<U>&, typename enable_if_c<!is_array<U>::value, nat>::type = nat()) :
+            destroy(&::boost::uptr_detail::destroy_object<U>)
+        {
+        }
+
+        /**
+         * Equivalent to: delete static_cast<T*>(ptr); with the T the deleter was created for
+         */
+        void operator()(void* ptr) const
+        {
+            BOOST_ASSERT_MSG(destroy != 0, "erased_delete has no destroy function");
+            destroy(ptr);
+        }
+
+        /**
+         * true if this deletes objects as exactly T
+         */
+        template<class T>
+        bool destroys(void) const
+        {
+            return destroy == &::boost::uptr_detail::destroy_object<T>;
+        }
+
+    private:
+        ::boost::uptr_detail::destroy_function destroy;
+    };
+
+    class erased_unique_ptr :
+        public unique_ptr<void, erased_delete>
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(erased_unique_ptr)
+
+        // Used for testing if templated copy constructor can participate in overload resolution
+        struct nat
+        {
+        };
+
+    public:
+        typedef unique_ptr<void, erased_delete> unique_type;
+
+        erased_unique_ptr(void) :
+            unique_type()
+        {
+        }
+
+        /**
+         * Takes ownership of p, which will be deleted as T.
+         */
+        template<class T>
+        explicit erased_unique_ptr(T* p) :
+            unique_type(const_cast<void*>(static_cast<const volatile void*>(p)),
+                erased_delete(&::boost::uptr_detail::destroy_object<T>))
+        {
+            BOOST_STATIC_ASSERT_MSG(!is_void<T>::value, "erased_unique_ptr needs the type of the object.");
+        }
+
+        /**
+         * Takes ownership of u's object, which will be deleted as U.
+         */
+        template<class U>
+        erased_unique_ptr(BOOST_RV_REF_BEG unique_ptr<U> BOOST_RV_REF_END u,
+                typename enable_if_c<!is_array<U>::value, nat>::type = nat()) :
+            unique_type(boost::move(u))
+        {
+        }
+
+        erased_unique_ptr(BOOST_RV_REF(erased_unique_ptr) u) :
+            unique_type(boost::move(static_cast<unique_type&>(u)))
+        {
+        }
+
+        erased_unique_ptr& operator=(BOOST_RV_REF(erased_unique_ptr) u)
+        {
+            unique_type::operator=(boost::move(static_cast<unique_type&>(u)));
+            return *this;
+        }
+
+        template<class U>
+        typename enable_if_c<!is_array<U>::value, erased_unique_ptr&>::type
+        operator=(BOOST_RV_REF_BEG unique_ptr<U> BOOST_RV_REF_END u)
+        {
+            erased_unique_ptr(boost::move(u)).swap(*this);
+            return *this;
+        }
+
+        /**
+         * Deletes the owned object, leaving this empty.
+         */
+        void reset(void)
+        {
+            unique_type::reset();
+        }
+
+        /**
+         * Deletes the owned object and takes ownership of p, which will be deleted as T.
+         */
+        template<class T>
+        void reset(T* p)
+        {
+            erased_unique_ptr(p).swap(*this);
+        }
+
+        void swap(erased_unique_ptr& u)
+        {
+            unique_type::swap(u);
+        }
+    };
+
+    inline void swap(erased_unique_ptr& a, erased_unique_ptr& b)
+    {
+        a.swap(b);
+    }
+
+    namespace uptr_detail
+    {
+        template<typename T>
+        struct make_erased_switch
+        {
+            typedef ::boost::erased_unique_ptr single_object;
+        };
+
+        // arrays aren't supported
+        template<typename T>
+        struct make_erased_switch<T[]>
+        {
+        };
+
+        template<typename T, std::size_t N>
+        struct make_erased_switch<T[N]>
+        {
+        };
+    }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    /**
+     * Equivalent to: erased_unique_ptr(new T(std::forward<Args>(args)...));
+     */
+    template<typename T, typename... Args>
+    inline typename ::boost::uptr_detail::make_erased_switch<T>::single_object
+    make_erased(Args&&... args)
+    {
+        return ::boost::erased_unique_ptr(new T(::boost::uptr_detail::forward<Args>(args)...));
+    }
+#else
+    /**
+     * Equivalent to: erased_unique_ptr(new T(a0, ..., an-1));
+     */
+#define BOOST_UPTR_MAKE_ERASED(z, n, data) \
+    template<typename T BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+    inline typename ::boost::uptr_detail::make_erased_switch<T>::single_object \
+    make_erased(BOOST_UPTR_FWD_PARAMS(n)) \
+    { \
+        return ::boost::erased_unique_ptr(new T(BOOST_UPTR_FWD_ARGS(n))); \
+    }
+
+    BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_MAKE_ERASED, ~)
+
+#undef BOOST_UPTR_MAKE_ERASED
+#endif
+}
+
+#endif // BOOST_ERASED_UNIQUE_PTR_HPP
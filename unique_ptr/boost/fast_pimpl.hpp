@@ -0,0 +1,216 @@
+//
+// fast_pimpl.hpp
+//
+// Pimpl without a heap allocation: the implementation object lives in storage reserved inside the outer class.
+//
+// fast_pimpl<Impl, Size, Align> holds an Impl in Size bytes aligned to Align. Like unique_ptr<Impl>, Impl may be
+// incomplete where the member is declared; every member function which needs Impl's definition is only
+// instantiated where it is called, so the outer class declares its constructors, destructor and assignments
+// in the header and defines them in the .cpp file after Impl:
+//
+//  // widget.hpp
+//  class widget
+//  {
+//  public:
+//      widget(int id);
+//      ~widget(void);
+//      int id(void) const;
+//  private:
+//      class impl;
+//      boost::fast_pimpl<impl, 32> pimpl;
+//  };
+//
+//  // widget.cpp
+//  class widget::impl { ... };
+//  widget::widget(int id) : pimpl(id) {}
+//  widget::~widget(void) {}
+//
+// The constructors and the destructor check that Size and Align are large enough for Impl, so a too small
+// reservation fails to compile in the .cpp file (the error names the required size and alignment).
+//
+// There is no null state: fast_pimpl always holds an Impl, a moved-from fast_pimpl holds a moved-from Impl.
+// Copies and moves copy and move the Impl. get(), operator-> and operator* propagate const.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_FAST_PIMPL_HPP
+#define BOOST_FAST_PIMPL_HPP
+
+#include <cstddef>
+#include <new>
+#include <boost/config.hpp>
+#include <boost/move/move.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/unique_ptr/detail/uptr_factory.hpp>
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+#else
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/preprocessor/repetition/repeat_from_to.hpp>
+#endif
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        // instantiated with the actual values so they show up in the error message
+        template<std::size_t Size, std::size_t Align, std::size_t ImplSize, std::size_t ImplAlign>
+        struct fast_pimpl_check
+        {
+            BOOST_STATIC_ASSERT_MSG(ImplSize <= Size, "fast_pimpl: Size is smaller than sizeof(Impl).");
+            BOOST_STATIC_ASSERT_MSG(Align % ImplAlign == 0, "fast_pimpl: Align is smaller than alignof(Impl).");
+
+            static void check(void)
+            {
+            }
+        };
+    }
+
+    template<class Impl, std::size_t Size, std::size_t Align = 2 * sizeof(void*)>
+    class fast_pimpl
+    {
+        BOOST_COPYABLE_AND_MOVABLE(fast_pimpl)
+
+        BOOST_STATIC_ASSERT_MSG(Align != 0 && (Align & (Align - 1)) == 0, "Align must be a power of 2.");
+
+    public:
+        typedef Impl element_type;
+
+        BOOST_STATIC_CONSTANT(std::size_t, size = Size);
+        BOOST_STATIC_CONSTANT(std::size_t, alignment = Align);
+
+        /**
+         * Equivalent to: Impl();
+         */
+        fast_pimpl(void)
+        {
+            check();
+            ::new (static_cast<void*>(&storage)) Impl();
+        }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+        /**
+         * Equivalent to: Impl(std::forward<A0>(a0), std::forward<Args>(args)...);
+         */
+        template<typename A0, typename... Args, typename = typename enable_if_c<
+            !is_same<typename decay<A0>::type, fast_pimpl>::value>::type>
+        explicit fast_pimpl(A0&& a0, Args&&... args)
+        {
+            check();
+            ::new (static_cast<void*>(&storage)) Impl(::boost::uptr_detail::forward<A0>(a0),
+                ::boost::uptr_detail::forward<Args>(args)...);
+        }
+#else
+        /**
+         * Equivalent to: Impl(a0, ..., an-1);
+         */
+#define BOOST_UPTR_FAST_PIMPL_CTOR(z, n, data) \
+        template<BOOST_PP_ENUM_PARAMS(n, typename A)> \
+        explicit fast_pimpl(BOOST_UPTR_FWD_PARAMS(n)) \
+        { \
+            check(); \
+            ::new (static_cast<void*>(&storage)) Impl(BOOST_UPTR_FWD_ARGS(n)); \
+        }
+
+        // at least one argument, the copy and move constructors win over A0 = fast_pimpl
+        BOOST_PP_REPEAT_FROM_TO(1, BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_FAST_PIMPL_CTOR, ~)
+
+#undef BOOST_UPTR_FAST_PIMPL_CTOR
+#endif
+
+        fast_pimpl(const fast_pimpl& u)
+        {
+            check();
+            ::new (static_cast<void*>(&storage)) Impl(*u.get());
+        }
+
+        fast_pimpl(BOOST_RV_REF(fast_pimpl) u)
+        {
+            check();
+            ::new (static_cast<void*>(&storage)) Impl(boost::move(*u.get()));
+        }
+
+        ~fast_pimpl(void)
+        {
+            check();
+            get()->~Impl();
+        }
+
+        fast_pimpl& operator=(BOOST_COPY_ASSIGN_REF(fast_pimpl) u)
+        {
+            *get() = *u.get();
+            return *this;
+        }
+
+        fast_pimpl& operator=(BOOST_RV_REF(fast_pimpl) u)
+        {
+            *get() = boost::move(*u.get());
+            return *this;
+        }
+
+        Impl* get(void)
+        {
+            return static_cast<Impl*>(static_cast<void*>(&storage));
+        }
+
+        const Impl* get(void) const
+        {
+            return static_cast<const Impl*>(static_cast<const void*>(&storage));
+        }
+
+        Impl& operator*(void)
+        {
+            return *get();
+        }
+
+        const Impl& operator*(void) const
+        {
+            return *get();
+        }
+
+        Impl* operator->(void)
+        {
+            return get();
+        }
+
+        const Impl* operator->(void) const
+        {
+            return get();
+        }
+
+        /**
+         * Swaps the Impl objects with three moves.
+         */
+        void swap(fast_pimpl& u)
+        {
+            Impl tmp(boost::move(*get()));
+            *get() = boost::move(*u.get());
+            *u.get() = boost::move(tmp);
+        }
+
+    private:
+        static void check(void)
+        {
+            ::boost::uptr_detail::fast_pimpl_check<Size, Align, sizeof(Impl), alignment_of<Impl>::value>::check();
+        }
+
+        typename aligned_storage<Size, Align>::type storage;
+    };
+
+    template<class Impl, std::size_t Size, std::size_t Align>
+    inline void swap(fast_pimpl<Impl, Size, Align>& a, fast_pimpl<Impl, Size, Align>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif // BOOST_FAST_PIMPL_HPP
@@ -0,0 +1,64 @@
+//
+// fn_delete.hpp
+//
+// Deleter calling a fixed function, chosen at compile time.
+//
+// unique_ptr<T, void (*)(T*)> stores a function pointer in every owner and calls through it.
+// fn_delete<F, Fn> takes the function as a template argument instead: it is an empty class, so the owner is
+// one pointer wide, and Fn is called directly where it can be inlined. F is the type of Fn, which
+// BOOST_UPTR_FN_DELETE(fn) fills in:
+//
+//  typedef boost::unique_ptr<std::FILE, BOOST_UPTR_FN_DELETE(&std::fclose)> unique_file;
+//  typedef boost::unique_ptr<char, BOOST_UPTR_FN_DELETE(&std::free)> unique_cstr;
+//
+// Fn must take one argument which the owned pointer converts to; its return value is ignored.
+// unique_ptr never calls it with a null pointer.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_FN_DELETE_HPP
+#define BOOST_FN_DELETE_HPP
+
+#include <boost/config.hpp>
+#include <boost/typeof/typeof.hpp>
+
+#define BOOST_UPTR_FN_DELETE(fn) ::boost::fn_delete<BOOST_TYPEOF(fn), fn>
+
+namespace boost
+{
+    template<class F, F Fn>
+    struct fn_delete;
+
+    template<class R, class P, R (*Fn)(P)>
+    struct fn_delete<R (*)(P), Fn>
+    {
+        /**
+         * Equivalent to: Fn(ptr);
+         */
+        void operator()(P ptr) const
+        {
+            Fn(ptr);
+        }
+    };
+
+#if defined(__cpp_noexcept_function_type)
+    // noexcept is part of the function type since C++17 (and the C library is declared noexcept)
+    template<class R, class P, R (*Fn)(P) noexcept>
+    struct fn_delete<R (*)(P) noexcept, Fn>
+    {
+        /**
+         * Equivalent to: Fn(ptr);
+         */
+        void operator()(P ptr) const
+        {
+            Fn(ptr);
+        }
+    };
+#endif
+}
+
+#endif // BOOST_FN_DELETE_HPP
@@ -0,0 +1,58 @@
+//
+// free_delete.hpp
+//
+// Deleter for memory obtained from std::malloc/std::calloc.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_FREE_DELETE_HPP
+#define BOOST_FREE_DELETE_HPP
+
+#include <boost/config.hpp>
+#include <cstdlib>
+
+namespace boost
+{
+    /**
+     * No destructors are run, so T should be a POD type.
+     */
+    template<class T>
+    struct free_delete
+    {
+        /**
+         * Equivalent to: std::free(ptr);
+         */
+        void operator()(T* ptr) const
+        {
+            std::free(ptr);
+        }
+    };
+
+    // array specialization
+    template<class T>
+    struct free_delete<T[]>
+    {
+#if defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+    private:
+        // prevents calling free on an array of U
+        template<class U> void operator()(U*) const;
+    public:
+#else
+        template<class U> void operator()(U*) const = delete;
+#endif
+
+        /**
+         * Equivalent to: std::free(ptr);
+         */
+        void operator()(T* ptr) const
+        {
+            std::free(ptr);
+        }
+    };
+}
+
+#endif // BOOST_FREE_DELETE_HPP
@@ -0,0 +1,378 @@
+//
+// inline_unique.hpp
+//
+// Polymorphic owner which stores small objects inside itself instead of on the heap.
+//
+// inline_unique<Base, Capacity, Align> owns one object of a type derived from (or equal to) Base.
+// emplace<T>(args...) constructs T in the internal buffer if it fits (sizeof(T) <= Capacity,
+// alignof(T) <= Align) and can be relocated without throwing, otherwise it allocates T with new.
+// get(), operator->, operator*, reset() and explicit bool work like unique_ptr<Base>:
+//
+//  boost::inline_unique<strategy> s;
+//  s.emplace<greedy_strategy>(limit);     // no allocation for a small greedy_strategy
+//  s->run(input);
+//
+// The owner captures one manager function for T when the object is created, which destroys it as T
+// (Base needs no virtual destructor) and relocates it when the owner is moved: inline objects are
+// move constructed into the new owner (or memcpy'd if is_trivially_relocatable<T>), so unlike
+// unique_ptr, moving an inline_unique changes the address of an inline object. There is no release().
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_INLINE_UNIQUE_HPP
+#define BOOST_INLINE_UNIQUE_HPP
+
+#include <cstddef>
+#include <new>
+#include <boost/config.hpp>
+#include <boost/move/move.hpp>
+#include <boost/relocate.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/add_reference.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_nothrow_move_constructible.hpp>
+#include <boost/unique_ptr/detail/uptr_aligned.hpp>
+#include <boost/unique_ptr/detail/uptr_factory.hpp>
+
+namespace boost
+{
+    template<class Base, std::size_t Capacity = 6 * sizeof(void*), std::size_t Align = 2 * sizeof(void*)>
+    class inline_unique
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(inline_unique)
+
+        BOOST_STATIC_ASSERT_MSG(Capacity >= sizeof(void*), "Capacity must fit a pointer.");
+        BOOST_STATIC_ASSERT_MSG(Align != 0 && (Align & (Align - 1)) == 0, "Align must be a power of 2.");
+
+        // destroys the object of from if to is null, otherwise relocates it into to
+        typedef void (*manager)(inline_unique& from, inline_unique* to);
+
+        template<bool Fits>
+        struct fits_tag
+        {
+        };
+
+    public:
+        typedef Base element_type;
+        typedef Base* pointer;
+
+        BOOST_STATIC_CONSTANT(std::size_t, capacity = Capacity);
+        BOOST_STATIC_CONSTANT(std::size_t, alignment = Align);
+
+        /**
+         * true if emplace<T> stores T inline
+         */
+        template<class T>
+        struct fits
+        {
+            BOOST_STATIC_CONSTANT(bool, value = sizeof(T) <= Capacity && alignment_of<T>::value <= Align
+                && (is_trivially_relocatable<T>::value || is_nothrow_move_constructible<T>::value));
+        };
+
+        inline_unique(void) :
+            ptr(), manage()
+        {
+        }
+
+        inline_unique(BOOST_RV_REF(inline_unique) u) :
+            ptr(), manage()
+        {
+            take(u);
+        }
+
+        ~inline_unique(void)
+        {
+            reset();
+        }
+
+        inline_unique& operator=(BOOST_RV_REF(inline_unique) u)
+        {
+            if(this != &u)
+            {
+                reset();
+                take(u);
+            }
+            return *this;
+        }
+
+        pointer get(void) const
+        {
+            return ptr;
+        }
+
+        typename add_reference<Base>::type operator*(void) const
+        {
+            return *ptr;
+        }
+
+        pointer operator->(void) const
+        {
+            return ptr;
+        }
+
+        /**
+         * true if the object lives in the internal buffer
+         */
+        bool is_inline(void) const
+        {
+            return ptr != 0 && static_cast<const void*>(ptr) >= static_cast<const void*>(&buffer)
+                && static_cast<const void*>(ptr) < static_cast<const void*>(&buffer + 1);
+        }
+
+        /**
+         * Destroys the owned object, leaving this empty.
+         */
+        void reset(void)
+        {
+            if(manage != 0)
+            {
+                const manager m = manage;
+                manage = 0;
+                ptr = 0;
+                m(*this, 0);
+            }
+        }
+
+        /**
+         * Destroys the owned object and takes ownership of p, which was allocated with new T.
+         * p must point to an object of exactly type T (not of a type derived from T), it is deleted as T.
+         */
+        template<class T>
+        void reset(T* p)
+        {
+            BOOST_STATIC_ASSERT_MSG((is_convertible<T*, Base*>::value), "T must derive from Base.");
+            reset();
+            if(p != 0)
+            {
+                *static_cast<T**>(static_cast<void*>(&buffer)) = p;
+                ptr = p;
+                manage = &manage_adopted<T>;
+            }
+        }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+        /**
+         * Destroys the owned object and constructs T(std::forward<Args>(args)...) in its place.
+         */
+        template<class T, typename... Args>
+        T& emplace(Args&&... args)
+        {
+            reset();
+            const fits_tag<fits<T>::value> where = fits_tag<fits<T>::value>();
+            void* mem = allocate(where, sizeof(T), alignment_of<T>::value);
+            T* p;
+            try
+            {
+                p = ::new (mem) T(::boost::uptr_detail::forward<Args>(args)...);
+            }
+            catch(...)
+            {
+                deallocate(where, mem, alignment_of<T>::value);
+                throw;
+            }
+            return adopt(p, where);
+        }
+#else
+        /**
+         * Destroys the owned object and constructs T(a0, ..., an-1) in its place.
+         */
+#define BOOST_UPTR_INLINE_EMPLACE(z, n, data) \
+        template<class T BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+        T& emplace(BOOST_UPTR_FWD_PARAMS(n)) \
+        { \
+            reset(); \
+            const fits_tag<fits<T>::value> where = fits_tag<fits<T>::value>(); \
+            void* mem = allocate(where, sizeof(T), alignment_of<T>::value); \
+            T* p; \
+            try \
+            { \
+                p = ::new (mem) T(BOOST_UPTR_FWD_ARGS(n)); \
+            } \
+            catch(...) \
+            { \
+                deallocate(where, mem, alignment_of<T>::value); \
+                throw; \
+            } \
+            return adopt(p, where); \
+        }
+
+        BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_INLINE_EMPLACE, ~)
+
+#undef BOOST_UPTR_INLINE_EMPLACE
+#endif
+
+        void swap(inline_unique& u)
+        {
+            inline_unique tmp(boost::move(u));
+            u = boost::move(*this);
+            *this = boost::move(tmp);
+        }
+
+#if defined(BOOST_NO_CXX11_EXPLICIT_CONVERSION_OPERATORS)
+        // safe bool idiom
+    private:
+        typedef void (*bool_type)();
+        static void this_type_does_not_support_comparisons()
+        {
+        }
+    public:
+        operator bool_type(void) const
+        {
+            return ptr != 0 ? &this_type_does_not_support_comparisons : 0;
+        }
+#else
+        explicit operator bool(void) const
+        {
+            return ptr != 0;
+        }
+#endif
+
+    private:
+        void* allocate(fits_tag<true>, std::size_t, std::size_t)
+        {
+            return &buffer;
+        }
+
+        // ::operator new only aligns to new_alignment
+        static void* allocate(fits_tag<false>, std::size_t size, std::size_t align)
+        {
+            if(align <= ::boost::uptr_detail::new_alignment)
+            {
+                return ::operator new(size);
+            }
+            void* mem = ::boost::uptr_detail::aligned_malloc(size, align);
+            if(mem == 0)
+            {
+                throw std::bad_alloc();
+            }
+            return mem;
+        }
+
+        static void deallocate(fits_tag<true>, void*, std::size_t)
+        {
+        }
+
+        static void deallocate(fits_tag<false>, void* mem, std::size_t align)
+        {
+            if(align <= ::boost::uptr_detail::new_alignment)
+            {
+                ::operator delete(mem);
+            }
+            else
+            {
+                ::boost::uptr_detail::aligned_free(mem);
+            }
+        }
+
+        template<class T>
+        T& adopt(T* p, fits_tag<true>)
+        {
+            BOOST_STATIC_ASSERT_MSG((is_convertible<T*, Base*>::value), "T must derive from Base.");
+            ptr = p;
+            manage = &manage_inline<T>;
+            return *p;
+        }
+
+        template<class T>
+        T& adopt(T* p, fits_tag<false>)
+        {
+            BOOST_STATIC_ASSERT_MSG((is_convertible<T*, Base*>::value), "T must derive from Base.");
+            *static_cast<T**>(static_cast<void*>(&buffer)) = p;
+            ptr = p;
+            manage = &manage_emplaced<T>;
+            return *p;
+        }
+
+        void take(inline_unique& u)
+        {
+            if(u.manage != 0)
+            {
+                u.manage(u, this);
+                manage = u.manage;
+                u.ptr = 0;
+                u.manage = 0;
+            }
+        }
+
+        // the object is in buffer
+        template<class T>
+        static void manage_inline(inline_unique& from, inline_unique* to)
+        {
+            T* obj = static_cast<T*>(static_cast<void*>(&from.buffer));
+            if(to == 0)
+            {
+                obj->~T();
+            }
+            else
+            {
+                T* dest = static_cast<T*>(static_cast<void*>(&to->buffer));
+                ::boost::uninitialized_relocate(obj, obj + 1, dest);
+                to->ptr = dest;
+            }
+        }
+
+        // buffer holds the T* of a heap object constructed by emplace in memory from allocate
+        template<class T>
+        static void manage_emplaced(inline_unique& from, inline_unique* to)
+        {
+            T* obj = *static_cast<T**>(static_cast<void*>(&from.buffer));
+            if(to == 0)
+            {
+                obj->~T();
+                deallocate(fits_tag<false>(), obj, alignment_of<T>::value);
+            }
+            else
+            {
+                move_heap<T>(from, *to);
+            }
+        }
+
+        // buffer holds the T* of a heap object passed to reset(T*), created by new T
+        template<class T>
+        static void manage_adopted(inline_unique& from, inline_unique* to)
+        {
+            if(to == 0)
+            {
+                // reset(T*) requires the object to be exactly a T, so a non-virtual destructor is fine here
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdelete-non-virtual-dtor"
+#endif
+                delete *static_cast<T**>(static_cast<void*>(&from.buffer));
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+            }
+            else
+            {
+                move_heap<T>(from, *to);
+            }
+        }
+
+        // heap objects stay where they are, only the pointer moves
+        template<class T>
+        static void move_heap(inline_unique& from, inline_unique& to)
+        {
+            *static_cast<T**>(static_cast<void*>(&to.buffer)) = *static_cast<T**>(static_cast<void*>(&from.buffer));
+            to.ptr = from.ptr;
+        }
+
+        typename aligned_storage<Capacity, Align>::type buffer;
+        Base* ptr;
+        manager manage;
+    };
+
+    template<class Base, std::size_t Capacity, std::size_t Align>
+    inline void swap(inline_unique<Base, Capacity, Align>& a, inline_unique<Base, Capacity, Align>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif // BOOST_INLINE_UNIQUE_HPP
@@ -1,6 +1,9 @@
 //
 // make_unique.hpp
 //
+// Replicates std::make_unique as proposed for C++14 (N3656),
+// plus factories for uninitialized and lazily zeroed arrays.
+//
 // (c) 2013 Andrew Ho
 //
 //  Distributed under the Boost Software License, Version 1.0. (See
@@ -10,9 +13,140 @@
 #ifndef MAKE_UNIQUE_HPP_
 #define MAKE_UNIQUE_HPP_
 
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_factory.hpp>
+#include <boost/free_delete.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/remove_extent.hpp>
+
 namespace boost
 {
+    namespace uptr_detail
+    {
+        // selects which make_unique overload participates in overload resolution
+        template<typename T>
+        struct make_unique_switch
+        {
+            typedef ::boost::unique_ptr<T> single_object;
+        };
+
+        template<typename T>
+        struct make_unique_switch<T[]>
+        {
+            typedef ::boost::unique_ptr<T[]> unknown_bound;
+            typedef ::boost::unique_ptr<T[], ::boost::free_delete<T[]> > unknown_bound_zeroed;
+        };
+
+        template<typename T, std::size_t N>
+        struct make_unique_switch<T[N]>
+        {
+            typedef void known_bound;
+        };
+    }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    /**
+     * Equivalent to: unique_ptr<T>(new T(std::forward<Args>(args)...));
+     */
+    template<typename T, typename... Args>
+    inline typename ::boost::uptr_detail::make_unique_switch<T>::single_object
+    make_unique(Args&&... args)
+    {
+        return ::boost::unique_ptr<T>(new T(::boost::uptr_detail::forward<Args>(args)...));
+    }
+#else
+    /**
+     * Equivalent to: unique_ptr<T>(new T(a0, ..., an-1));
+     */
+#define BOOST_UPTR_MAKE_UNIQUE(z, n, data) \
+    template<typename T BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+    inline typename ::boost::uptr_detail::make_unique_switch<T>::single_object \
+    make_unique(BOOST_UPTR_FWD_PARAMS(n)) \
+    { \
+        return ::boost::unique_ptr<T>(new T(BOOST_UPTR_FWD_ARGS(n))); \
+    }
+
+    BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_MAKE_UNIQUE, ~)
+
+#undef BOOST_UPTR_MAKE_UNIQUE
+#endif
+
+    /**
+     * Equivalent to: unique_ptr<T[]>(new T[n]());
+     */
+    template<typename T>
+    inline typename ::boost::uptr_detail::make_unique_switch<T>::unknown_bound
+    make_unique(std::size_t n)
+    {
+        typedef typename ::boost::remove_extent<T>::type element_type;
+        return ::boost::unique_ptr<T>(new element_type[n]());
+    }
+
+    /**
+     * Equivalent to: unique_ptr<T>(new T);
+     * T is default-initialized, so POD types are left uninitialized.
+     */
+    template<typename T>
+    inline typename ::boost::uptr_detail::make_unique_switch<T>::single_object
+    make_unique_for_overwrite(void)
+    {
+        return ::boost::unique_ptr<T>(new T);
+    }
+
+    /**
+     * Equivalent to: unique_ptr<T[]>(new T[n]);
+     * Elements are default-initialized, so POD arrays are neither zeroed nor touched.
+     */
+    template<typename T>
+    inline typename ::boost::uptr_detail::make_unique_switch<T>::unknown_bound
+    make_unique_for_overwrite(std::size_t n)
+    {
+        typedef typename ::boost::remove_extent<T>::type element_type;
+        return ::boost::unique_ptr<T>(new element_type[n]);
+    }
+
+    /**
+     * Zero-initialized array of n elements allocated with std::calloc and released with std::free.
+     * Large blocks come straight from the OS already zeroed, so pages are only faulted in on first use
+     * instead of being cleared up front.
+     * Throws std::bad_alloc on failure.
+     */
+    template<typename T>
+    inline typename ::boost::uptr_detail::make_unique_switch<T>::unknown_bound_zeroed
+    make_unique_zeroed(std::size_t n)
+    {
+        typedef typename ::boost::remove_extent<T>::type element_type;
+        BOOST_STATIC_ASSERT_MSG(::boost::is_pod<element_type>::value,
+            "make_unique_zeroed doesn't run constructors or destructors, T must be a POD type.");
+        void* mem = std::calloc(n == 0 ? 1 : n, sizeof(element_type));
+        if(mem == 0)
+        {
+            throw std::bad_alloc();
+        }
+        return typename ::boost::uptr_detail::make_unique_switch<T>::unknown_bound_zeroed(
+            static_cast<element_type*>(mem));
+    }
+
+    // arrays of known bound can't be created with make_unique
+#if !defined(BOOST_NO_CXX11_DELETED_FUNCTIONS) && defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    template<typename T, typename... Args>
+    typename ::boost::uptr_detail::make_unique_switch<T>::known_bound
+    make_unique(Args&&...) = delete;
+
+    template<typename T, typename... Args>
+    typename ::boost::uptr_detail::make_unique_switch<T>::known_bound
+    make_unique_for_overwrite(Args&&...) = delete;
 
+    template<typename T, typename... Args>
+    typename ::boost::uptr_detail::make_unique_switch<T>::known_bound
+    make_unique_zeroed(Args&&...) = delete;
+#endif
+    // otherwise make_unique_switch<T[N]> doesn't define single_object or unknown_bound,
+    // so there is no make_unique overload to call
 }
 
 
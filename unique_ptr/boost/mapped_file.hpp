@@ -0,0 +1,331 @@
+//
+// mapped_file.hpp
+//
+// Zero-copy ownership of memory mapped files.
+//
+// unmap_file is a deleter whose pointer type is file_mapping (address, length and descriptor of a mapping),
+// so unique_ptr<void, unmap_file> owns a mapping through the custom pointer hook: releasing it munmaps
+// the file and closes the descriptor.
+//
+// mapped_file wraps such a unique_ptr with size(), data(), typed views and madvise hints.
+// map_readonly(path) and map_readwrite(path) map a whole file shared, so the pages come straight from
+// the page cache and are shared with other processes mapping the same file. Writes through a
+// map_readwrite mapping go to the file.
+//
+// Failures throw std::runtime_error with the reason reported by the system.
+//
+// POSIX only.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MAPPED_FILE_HPP
+#define BOOST_MAPPED_FILE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <boost/unique_ptr.hpp>
+
+namespace boost
+{
+    /**
+     * Nullable handle of a file mapping, used as unmap_file::pointer.
+     * Null (value-initialized or constructed from nullptr/NULL) has no address and no descriptor.
+     */
+    struct file_mapping
+    {
+    private:
+        struct nat
+        {
+            int dummy;
+        };
+
+    public:
+        file_mapping(void) :
+            address(), length(), fd(-1), writable()
+        {
+        }
+
+        /**
+         * Null mapping, accepts nullptr and NULL
+         */
+        file_mapping(int nat::*) :
+            address(), length(), fd(-1), writable()
+        {
+        }
+
+        file_mapping(void* address, std::size_t length, int fd, bool writable) :
+            address(address), length(length), fd(fd), writable(writable)
+        {
+        }
+
+        // file_mapping is returned by unique_ptr::operator->, so mapping->length works
+        const file_mapping* operator->(void) const
+        {
+            return this;
+        }
+
+#if !defined(BOOST_NO_CXX11_EXPLICIT_CONVERSION_OPERATORS)
+        // some standard library implementations test pointers with if(p)
+        // (no safe bool for C++03, it would make comparisons with NULL ambiguous)
+        explicit operator bool(void) const
+        {
+            return *this != file_mapping();
+        }
+#endif
+
+        friend bool operator==(const file_mapping& a, const file_mapping& b)
+        {
+            return a.address == b.address && a.fd == b.fd;
+        }
+
+        friend bool operator!=(const file_mapping& a, const file_mapping& b)
+        {
+            return !(a == b);
+        }
+
+        friend bool operator<(const file_mapping& a, const file_mapping& b)
+        {
+            return std::less<void*>()(a.address, b.address) || (a.address == b.address && a.fd < b.fd);
+        }
+
+        void* address;
+        std::size_t length;
+        int fd;
+        bool writable;
+    };
+
+    /**
+     * Deleter for file mappings: munmaps the mapping and closes its descriptor.
+     */
+    struct unmap_file
+    {
+        typedef file_mapping pointer;
+
+        void operator()(const file_mapping& m) const
+        {
+            if(m.address != 0)
+            {
+                ::munmap(m.address, m.length);
+            }
+            if(m.fd >= 0)
+            {
+                ::close(m.fd);
+            }
+        }
+    };
+
+    class mapped_file
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(mapped_file)
+
+    public:
+        typedef unique_ptr<void, unmap_file> owner_type;
+
+        enum advice
+        {
+            advise_normal = MADV_NORMAL,
+            advise_sequential = MADV_SEQUENTIAL,
+            advise_random = MADV_RANDOM,
+            advise_willneed = MADV_WILLNEED,
+            advise_dontneed = MADV_DONTNEED
+        };
+
+        mapped_file(void)
+        {
+        }
+
+        /**
+         * Takes ownership of m.
+         */
+        explicit mapped_file(const file_mapping& m) :
+            owner(m)
+        {
+        }
+
+        mapped_file(BOOST_RV_REF(mapped_file) f) :
+            owner(boost::move(f.owner))
+        {
+        }
+
+        mapped_file& operator=(BOOST_RV_REF(mapped_file) f)
+        {
+            owner = boost::move(f.owner);
+            return *this;
+        }
+
+        /**
+         * Size of the mapped file in bytes
+         */
+        std::size_t size(void) const
+        {
+            return owner.get().length;
+        }
+
+        bool empty(void) const
+        {
+            return size() == 0;
+        }
+
+        /**
+         * Start of the mapping. Writing through a read only mapping raises SIGSEGV.
+         */
+        char* data(void) const
+        {
+            return static_cast<char*>(owner.get().address);
+        }
+
+        bool writable(void) const
+        {
+            return owner.get().writable;
+        }
+
+        int native_handle(void) const
+        {
+            return owner.get().fd;
+        }
+
+        /**
+         * The file viewed as T objects starting at offset, which must be suitably aligned for T.
+         * Throws std::out_of_range if not even one T fits.
+         */
+        template<class T>
+        T* view(std::size_t offset = 0) const
+        {
+            if(offset > size() || size() - offset < sizeof(T))
+            {
+                throw std::out_of_range("mapped_file::view");
+            }
+            return reinterpret_cast<T*>(data() + offset);
+        }
+
+        /**
+         * Number of whole T objects in the file starting at offset
+         */
+        template<class T>
+        std::size_t count(std::size_t offset = 0) const
+        {
+            return offset < size() ? (size() - offset) / sizeof(T) : 0;
+        }
+
+        /**
+         * Tells the kernel how the mapping will be accessed. Returns false if the hint was rejected.
+         */
+        bool advise(advice a) const
+        {
+            return empty() || ::madvise(owner.get().address, size(), a) == 0;
+        }
+
+        /**
+         * Hint for the range [offset, offset + length), offset is rounded down to a page boundary.
+         */
+        bool advise(advice a, std::size_t offset, std::size_t length) const
+        {
+            if(offset >= size())
+            {
+                return true;
+            }
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t start = offset / page * page;
+            // offset < size(), so neither side can wrap
+            const std::size_t end = length >= size() - offset ? size() : offset + length;
+            return ::madvise(data() + start, end - start, a) == 0;
+        }
+
+        const owner_type& get_owner(void) const
+        {
+            return owner;
+        }
+
+        /**
+         * Gives up ownership of the mapping and its descriptor.
+         */
+        file_mapping release(void)
+        {
+            return owner.release();
+        }
+
+        void reset(void)
+        {
+            owner.reset();
+        }
+
+        void swap(mapped_file& f)
+        {
+            owner.swap(f.owner);
+        }
+
+    private:
+        owner_type owner;
+    };
+
+    inline void swap(mapped_file& a, mapped_file& b)
+    {
+        a.swap(b);
+    }
+
+    namespace uptr_detail
+    {
+        inline void throw_map_error(const char* what, const char* path)
+        {
+            throw std::runtime_error(std::string(what) + " " + path + ": " + std::strerror(errno));
+        }
+
+        inline mapped_file map_file(const char* path, bool writable)
+        {
+            const int fd = ::open(path, writable ? O_RDWR : O_RDONLY);
+            if(fd < 0)
+            {
+                throw_map_error("open", path);
+            }
+            // owns the descriptor from here on
+            mapped_file f(file_mapping(0, 0, fd, writable));
+            struct stat st;
+            if(::fstat(fd, &st) != 0)
+            {
+                throw_map_error("fstat", path);
+            }
+            const std::size_t length = static_cast<std::size_t>(st.st_size);
+            if(length == 0)
+            {
+                return boost::move(f);
+            }
+            void* address = ::mmap(0, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+            if(address == MAP_FAILED)
+            {
+                throw_map_error("mmap", path);
+            }
+            f.release();
+            return mapped_file(file_mapping(address, length, fd, writable));
+        }
+    }
+
+    /**
+     * Maps the whole file at path for reading.
+     */
+    inline mapped_file map_readonly(const char* path)
+    {
+        return ::boost::uptr_detail::map_file(path, false);
+    }
+
+    /**
+     * Maps the whole file at path for reading and writing, writes go to the file.
+     */
+    inline mapped_file map_readwrite(const char* path)
+    {
+        return ::boost::uptr_detail::map_file(path, true);
+    }
+}
+
+#endif // BOOST_MAPPED_FILE_HPP
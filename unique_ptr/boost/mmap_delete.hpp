@@ -0,0 +1,295 @@
+//
+// mmap_delete.hpp
+//
+// Arrays backed by anonymous memory mappings, for large tables whose page level behavior matters.
+//
+// make_unique_mapped<T[]>(n, options) maps n value-initialized elements and returns a
+// unique_ptr<T[], mmap_delete<T[]> >. options is a combination of:
+//
+//  map_huge_pages  align the mapping to BOOST_UPTR_HUGE_PAGE_SIZE and request transparent huge pages
+//                  (madvise(MADV_HUGEPAGE), ignored where unsupported)
+//  map_populate    prefault every page up front instead of on first touch
+//  map_lock        mlock the mapping so it is never paged out
+//
+// Throws std::bad_alloc if the mapping can't be created or locked (mlock is subject to RLIMIT_MEMLOCK).
+// mmap_delete destroys the elements and munmaps the mapping.
+//
+// POSIX only.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MMAP_DELETE_HPP
+#define BOOST_MMAP_DELETE_HPP
+
+#include <cstddef>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <boost/cstdint.hpp>
+#include <boost/make_unique.hpp>
+#include <boost/type_traits/has_trivial_constructor.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/remove_extent.hpp>
+
+#if !defined(BOOST_UPTR_HUGE_PAGE_SIZE)
+#define BOOST_UPTR_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+namespace boost
+{
+    enum map_options
+    {
+        map_default = 0,
+        map_huge_pages = 1 << 0,
+        map_populate = 1 << 1,
+        map_lock = 1 << 2
+    };
+
+    template<class T>
+    struct mmap_delete;
+
+    // only arrays are supported
+    // stores the element count and the length of the mapping
+    template<class T>
+    struct mmap_delete<T[]>
+    {
+        mmap_delete(void) :
+            count(), bytes()
+        {
+        }
+
+        mmap_delete(std::size_t count, std::size_t length) :
+            count(count), bytes(length)
+        {
+        }
+
+#if defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+    private:
+        // prevents deleting an array of U
+        template<class U> void operator()(U*) const;
+    public:
+#else
+        template<class U> void operator()(U*) const = delete;
+#endif
+
+        /**
+         * Destroys all elements in reverse order, then equivalent to: munmap(ptr, length());
+         */
+        void operator()(T* ptr) const
+        {
+            if(!has_trivial_destructor<T>::value)
+            {
+                for(std::size_t i = count; i > 0; --i)
+                {
+                    ptr[i - 1].~T();
+                }
+            }
+            ::munmap(static_cast<void*>(ptr), bytes);
+        }
+
+        std::size_t size(void) const
+        {
+            return count;
+        }
+
+        /**
+         * Length of the mapping in bytes
+         */
+        std::size_t length(void) const
+        {
+            return bytes;
+        }
+
+    private:
+        std::size_t count;
+        std::size_t bytes;
+    };
+
+    namespace uptr_detail
+    {
+        template<typename T>
+        struct make_unique_mapped_switch
+        {
+        };
+
+        template<typename T>
+        struct make_unique_mapped_switch<T[]>
+        {
+            typedef ::boost::unique_ptr<T[], ::boost::mmap_delete<T[]> > unknown_bound;
+        };
+
+        template<typename T, std::size_t N>
+        struct make_unique_mapped_switch<T[N]>
+        {
+            typedef void known_bound;
+        };
+
+        // unmaps if setting up the mapping fails
+        class mapping_guard
+        {
+        public:
+            mapping_guard(void* p, std::size_t length) :
+                block(p), length(length)
+            {
+            }
+
+            ~mapping_guard(void)
+            {
+                if(block != 0)
+                {
+                    ::munmap(block, length);
+                }
+            }
+
+            void* release(void)
+            {
+                void* p = block;
+                block = 0;
+                return p;
+            }
+
+            void* block;
+            std::size_t length;
+        };
+
+        inline std::size_t round_up(std::size_t n, std::size_t multiple)
+        {
+            return (n + multiple - 1) / multiple * multiple;
+        }
+
+        // maps length bytes (a multiple of the page size), aligned to align
+        inline void* map_anonymous(std::size_t length, std::size_t align, int flags)
+        {
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t extra = align > page ? align - page : 0;
+            if(length + extra < length)
+            {
+                throw std::bad_alloc();
+            }
+            void* p = ::mmap(0, length + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+            if(p == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            if(extra != 0)
+            {
+                // trim the unaligned head and the unused tail
+                char* const raw = static_cast<char*>(p);
+                char* const aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(raw), align));
+                const std::size_t head = static_cast<std::size_t>(aligned - raw);
+                if(head != 0)
+                {
+                    ::munmap(raw, head);
+                }
+                if(extra != head)
+                {
+                    ::munmap(aligned + length, extra - head);
+                }
+                p = aligned;
+            }
+            return p;
+        }
+
+        inline void prefault(void* p, std::size_t length)
+        {
+#if defined(MADV_POPULATE_WRITE)
+            if(::madvise(p, length, MADV_POPULATE_WRITE) == 0)
+            {
+                return;
+            }
+#endif
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            volatile char* const bytes = static_cast<volatile char*>(p);
+            for(std::size_t i = 0; i < length; i += page)
+            {
+                bytes[i] = 0;
+            }
+        }
+    }
+
+    /**
+     * Maps n value-initialized elements with the page behavior requested by options (see map_options).
+     * Returns an empty unique_ptr if n is 0.
+     */
+    template<typename T>
+    inline typename ::boost::uptr_detail::make_unique_mapped_switch<T>::unknown_bound
+    make_unique_mapped(std::size_t n, unsigned options = map_default)
+    {
+        typedef typename remove_extent<T>::type element_type;
+        typedef typename ::boost::uptr_detail::make_unique_mapped_switch<T>::unknown_bound result_type;
+        if(n == 0)
+        {
+            return result_type();
+        }
+        if(n > (static_cast<std::size_t>(-1) - 2 * BOOST_UPTR_HUGE_PAGE_SIZE) / sizeof(element_type))
+        {
+            throw std::bad_alloc();
+        }
+
+        const bool huge = (options & map_huge_pages) != 0;
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t length = ::boost::uptr_detail::round_up(n * sizeof(element_type),
+            huge ? BOOST_UPTR_HUGE_PAGE_SIZE : page);
+        int flags = 0;
+#if defined(MAP_POPULATE)
+        // huge pages must be requested before the pages are faulted in
+        if((options & map_populate) != 0 && !huge)
+        {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        ::boost::uptr_detail::mapping_guard guard(
+            ::boost::uptr_detail::map_anonymous(length, huge ? BOOST_UPTR_HUGE_PAGE_SIZE : page, flags), length);
+#if defined(MADV_HUGEPAGE)
+        if(huge)
+        {
+            ::madvise(guard.block, length, MADV_HUGEPAGE);
+        }
+#endif
+        if((options & map_populate) != 0 && (huge || flags == 0))
+        {
+            ::boost::uptr_detail::prefault(guard.block, length);
+        }
+        if((options & map_lock) != 0 && ::mlock(guard.block, length) != 0)
+        {
+            throw std::bad_alloc();
+        }
+
+        // anonymous mappings are zero filled, which already is the value of trivial types
+        element_type* mem = static_cast<element_type*>(guard.block);
+        if(!has_trivial_constructor<element_type>::value)
+        {
+            std::size_t i = 0;
+            try
+            {
+                for(; i < n; ++i)
+                {
+                    new (mem + i) element_type();
+                }
+            }
+            catch(...)
+            {
+                for(; i > 0; --i)
+                {
+                    mem[i - 1].~element_type();
+                }
+                throw;
+            }
+        }
+        guard.release();
+        return result_type(mem, mmap_delete<T>(n, length));
+    }
+
+    // arrays of known bound can't be created with make_unique_mapped
+#if !defined(BOOST_NO_CXX11_DELETED_FUNCTIONS) && defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    template<typename T, typename... Args>
+    typename ::boost::uptr_detail::make_unique_mapped_switch<T>::known_bound
+    make_unique_mapped(Args&&...) = delete;
+#endif
+}
+
+#endif // BOOST_MMAP_DELETE_HPP
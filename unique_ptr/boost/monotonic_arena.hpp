@@ -0,0 +1,335 @@
+//
+// monotonic_arena.hpp
+//
+// Bump-pointer arena for request-scoped objects owned by unique_ptr.
+//
+// make_unique_in<T>(arena, args...) constructs T in the arena and returns a unique_ptr<T, arena_delete<T> >.
+// arena_delete only runs the destructor; the memory is reclaimed in bulk by monotonic_arena::reset()
+// or when the arena is destroyed. All objects allocated from an arena must be destroyed before the arena
+// is reset or destroyed.
+//
+// monotonic_arena is not thread safe.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MONOTONIC_ARENA_HPP
+#define BOOST_MONOTONIC_ARENA_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/make_unique.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/remove_extent.hpp>
+#include <boost/utility/enable_if.hpp>
+
+namespace boost
+{
+    class monotonic_arena : private noncopyable
+    {
+        // chunks form a singly linked list, newest first
+        struct chunk
+        {
+            chunk* next;
+            std::size_t size;
+        };
+
+    public:
+        BOOST_STATIC_CONSTANT(std::size_t, default_chunk_size = 64 * 1024);
+
+        explicit monotonic_arena(std::size_t chunk_size = default_chunk_size) :
+            chunks(), cur(), end(), chunk_size(chunk_size)
+        {
+        }
+
+        ~monotonic_arena(void)
+        {
+            release();
+        }
+
+        /**
+         * Returns size bytes aligned to align (a power of 2). Throws std::bad_alloc on failure.
+         */
+        void* allocate(std::size_t size, std::size_t align)
+        {
+            char* p = align_up(cur, align);
+            if(p != 0 && p <= end && size <= static_cast<std::size_t>(end - p))
+            {
+                cur = p + size;
+                return p;
+            }
+            return allocate_slow(size, align);
+        }
+
+        /**
+         * Rewinds the arena, keeping the oldest regular sized chunk for reuse and freeing the rest.
+         */
+        void reset(void)
+        {
+            chunk* keep = 0;
+            while(chunks != 0)
+            {
+                chunk* next = chunks->next;
+                if(next == 0 && chunks->size == chunk_size)
+                {
+                    keep = chunks;
+                }
+                else
+                {
+                    std::free(chunks);
+                }
+                chunks = next;
+            }
+            chunks = keep;
+            cur = keep != 0 ? data(keep) : 0;
+            end = keep != 0 ? data(keep) + keep->size : 0;
+        }
+
+        /**
+         * Frees all chunks.
+         */
+        void release(void)
+        {
+            while(chunks != 0)
+            {
+                chunk* next = chunks->next;
+                std::free(chunks);
+                chunks = next;
+            }
+            cur = 0;
+            end = 0;
+        }
+
+    private:
+        static char* data(chunk* c)
+        {
+            return reinterpret_cast<char*>(c) + header_size;
+        }
+
+        static char* align_up(char* p, std::size_t align)
+        {
+            const uintptr_t mask = static_cast<uintptr_t>(align - 1);
+            return reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(p) + mask) & ~mask);
+        }
+
+        void* allocate_slow(std::size_t size, std::size_t align)
+        {
+            const std::size_t needed = size + align - 1;
+            if(needed < size)
+            {
+                throw std::bad_alloc();
+            }
+            // big allocations get a dedicated chunk so the current chunk can still be bumped
+            const bool dedicated = needed > chunk_size / 4;
+            const std::size_t capacity = dedicated ? needed : chunk_size;
+            chunk* c = static_cast<chunk*>(std::malloc(header_size + capacity));
+            if(c == 0)
+            {
+                throw std::bad_alloc();
+            }
+            c->size = capacity;
+            char* p = align_up(data(c), align);
+            if(dedicated && chunks != 0)
+            {
+                c->next = chunks->next;
+                chunks->next = c;
+            }
+            else
+            {
+                c->next = chunks;
+                chunks = c;
+                cur = p + size;
+                end = data(c) + capacity;
+            }
+            return p;
+        }
+
+        // keeps chunk data aligned for any fundamental type
+        BOOST_STATIC_CONSTANT(std::size_t, header_size = (sizeof(chunk) + 15) & ~static_cast<std::size_t>(15));
+
+        chunk* chunks;
+        char* cur;
+        char* end;
+        std::size_t chunk_size;
+    };
+
+    /**
+     * Deleter for objects created by make_unique_in. Only runs the destructor, the memory belongs to the arena.
+     */
+    template<class T>
+    struct arena_delete
+    {
+    private:
+        // Used for testing if templated copy constructor can participate in overload resolution
+        struct nat
+        {
+        };
+
+    public:
+        arena_delete(void)
+        {
+        }
+
+        template<class U>
+        arena_delete(const arena_delete<U>&, typename enable_if_c<
+                is_convertible<U*, T*>::value, nat>::type = nat())
+        {
+        }
+
+        /**
+         * Equivalent to: ptr->~T();
+         */
+        void operator()(T* ptr) const
+        {
+            ptr->~T();
+        }
+    };
+
+    // array specialization
+    // stores the element count so every element can be destroyed
+    template<class T>
+    struct arena_delete<T[]>
+    {
+        arena_delete(void) :
+            count()
+        {
+        }
+
+        explicit arena_delete(std::size_t count) :
+            count(count)
+        {
+        }
+
+#if defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+    private:
+        // prevents destroying an array of U
+        template<class U> void operator()(U*) const;
+    public:
+#else
+        template<class U> void operator()(U*) const = delete;
+#endif
+
+        /**
+         * Destroys all elements in reverse order
+         */
+        void operator()(T* ptr) const
+        {
+            if(!has_trivial_destructor<T>::value)
+            {
+                for(std::size_t i = count; i > 0; --i)
+                {
+                    ptr[i - 1].~T();
+                }
+            }
+        }
+
+        std::size_t size(void) const
+        {
+            return count;
+        }
+
+    private:
+        std::size_t count;
+    };
+
+    namespace uptr_detail
+    {
+        template<typename T>
+        struct make_unique_in_switch
+        {
+            typedef ::boost::unique_ptr<T, ::boost::arena_delete<T> > single_object;
+        };
+
+        template<typename T>
+        struct make_unique_in_switch<T[]>
+        {
+            typedef ::boost::unique_ptr<T[], ::boost::arena_delete<T[]> > unknown_bound;
+        };
+
+        template<typename T, std::size_t N>
+        struct make_unique_in_switch<T[N]>
+        {
+            typedef void known_bound;
+        };
+    }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    /**
+     * Equivalent to: unique_ptr<T, arena_delete<T> >(new (arena) T(std::forward<Args>(args)...));
+     */
+    template<typename T, typename... Args>
+    inline typename ::boost::uptr_detail::make_unique_in_switch<T>::single_object
+    make_unique_in(monotonic_arena& arena, Args&&... args)
+    {
+        void* mem = arena.allocate(sizeof(T), alignment_of<T>::value);
+        return typename ::boost::uptr_detail::make_unique_in_switch<T>::single_object(
+            new (mem) T(::boost::uptr_detail::forward<Args>(args)...));
+    }
+#else
+    /**
+     * Equivalent to: unique_ptr<T, arena_delete<T> >(new (arena) T(a0, ..., an-1));
+     */
+#define BOOST_UPTR_MAKE_UNIQUE_IN(z, n, data) \
+    template<typename T BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+    inline typename ::boost::uptr_detail::make_unique_in_switch<T>::single_object \
+    make_unique_in(monotonic_arena& arena BOOST_UPTR_FWD_TRAILING_PARAMS(n)) \
+    { \
+        void* mem = arena.allocate(sizeof(T), alignment_of<T>::value); \
+        return typename ::boost::uptr_detail::make_unique_in_switch<T>::single_object( \
+            new (mem) T(BOOST_UPTR_FWD_ARGS(n))); \
+    }
+
+    BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_MAKE_UNIQUE_IN, ~)
+
+#undef BOOST_UPTR_MAKE_UNIQUE_IN
+#endif
+
+    /**
+     * Array of n value-initialized elements allocated in arena.
+     */
+    template<typename T>
+    inline typename ::boost::uptr_detail::make_unique_in_switch<T>::unknown_bound
+    make_unique_in(monotonic_arena& arena, std::size_t n)
+    {
+        typedef typename remove_extent<T>::type element_type;
+        if(n > static_cast<std::size_t>(-1) / sizeof(element_type))
+        {
+            throw std::bad_alloc();
+        }
+        element_type* mem = static_cast<element_type*>(
+            arena.allocate(n * sizeof(element_type), alignment_of<element_type>::value));
+        std::size_t i = 0;
+        try
+        {
+            for(; i < n; ++i)
+            {
+                new (mem + i) element_type();
+            }
+        }
+        catch(...)
+        {
+            // destroy what was constructed so far, memory stays with the arena
+            const arena_delete<T> destroy(i);
+            destroy(mem);
+            throw;
+        }
+        return typename ::boost::uptr_detail::make_unique_in_switch<T>::unknown_bound(mem, arena_delete<T>(n));
+    }
+
+    // arrays of known bound can't be created with make_unique_in
+#if !defined(BOOST_NO_CXX11_DELETED_FUNCTIONS) && defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    template<typename T, typename... Args>
+    typename ::boost::uptr_detail::make_unique_in_switch<T>::known_bound
+    make_unique_in(monotonic_arena&, Args&&...) = delete;
+#endif
+}
+
+#endif // BOOST_MONOTONIC_ARENA_HPP
@@ -0,0 +1,471 @@
+//
+// pool_delete.hpp
+//
+// Thread-caching size-class allocator for single objects owned by unique_ptr.
+//
+// make_unique_pooled<T>(args...) returns a unique_ptr<T, pool_delete<T> >. The size class is picked at
+// compile time from sizeof(T); objects larger than pool_max_size (or aligned to more than pool_granularity)
+// fall back to an aligned allocation from the system heap.
+//
+// Each thread owns a cache of per-size-class free lists carved out of slabs. Freeing a block owned by
+// another thread's cache batches it up locally and hands the whole batch back to the owning cache with a
+// single compare-and-swap, so objects created on one thread and destroyed on another don't contend on a
+// global allocator lock.
+//
+// Slabs are never returned to the OS. When a thread exits its cache is recycled by the next new thread.
+// Without C++11 thread_local there is no thread exit hook: call release_pool_thread_cache() before a
+// thread that used the pool exits.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_POOL_DELETE_HPP
+#define BOOST_POOL_DELETE_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/make_unique.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_array.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/unique_ptr/detail/uptr_aligned.hpp>
+#include <boost/unique_ptr/detail/uptr_concurrency.hpp>
+#include <boost/utility/enable_if.hpp>
+
+namespace boost
+{
+    // objects up to pool_max_size bytes are served from size classes pool_granularity bytes apart
+    const std::size_t pool_granularity = 16;
+    const std::size_t pool_max_size = 256;
+
+    namespace uptr_detail
+    {
+        namespace pool
+        {
+            const std::size_t class_count = pool_max_size / pool_granularity;
+            // slabs are aligned to their size so the owning slab of a block is found by masking its address
+            const std::size_t slab_size = 64 * 1024;
+            // number of blocks owned by another cache collected before handing them back
+            const std::size_t remote_batch = 32;
+
+            struct free_block
+            {
+                free_block* next;
+            };
+
+            struct thread_cache;
+
+            struct slab_header
+            {
+                thread_cache* owner;
+                std::size_t size_class;
+            };
+
+            // header is padded so blocks stay aligned for any fundamental type
+            const std::size_t slab_header_size = (sizeof(slab_header) + cache_line_size - 1) & ~(cache_line_size - 1);
+
+            // only touched by the thread currently using the cache
+            struct local_class
+            {
+                free_block* free_list;
+                char* bump;
+                char* bump_end;
+
+                // blocks this thread freed which belong to pending_owner
+                thread_cache* pending_owner;
+                free_block* pending_head;
+                free_block* pending_tail;
+                std::size_t pending_count;
+            };
+
+            struct thread_cache
+            {
+                local_class local[class_count];
+                // blocks returned by other threads, pushed with compare-and-swap and drained all at once
+                char pad1[cache_line_size];
+                atomic<free_block*> remote[class_count];
+                char pad2[cache_line_size];
+                atomic<bool> in_use;
+                // registry link, never changes once the cache is published
+                thread_cache* next_cache;
+            };
+
+            inline slab_header* slab_of(void* p)
+            {
+                return reinterpret_cast<slab_header*>(reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(slab_size - 1));
+            }
+
+            // statics are members of a class template so they are defined once across translation units
+            template<typename Dummy = void>
+            struct impl
+            {
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+                // gives the cache back on thread exit
+                struct cache_handle
+                {
+                    thread_cache* cache;
+
+                    ~cache_handle(void)
+                    {
+                        impl::release();
+                    }
+                };
+                static thread_local cache_handle local;
+#else
+                struct cache_handle
+                {
+                    thread_cache* cache;
+                };
+                static BOOST_UPTR_THREAD_LOCAL cache_handle local;
+#endif
+                // every cache ever created, caches are never freed
+                static atomic<thread_cache*> registry;
+
+                static thread_cache& cache(void)
+                {
+                    thread_cache* c = local.cache;
+                    if(c == 0)
+                    {
+                        c = adopt();
+                        local.cache = c;
+                    }
+                    return *c;
+                }
+
+                static void* allocate(std::size_t size_class)
+                {
+                    thread_cache& self = cache();
+                    local_class& lc = self.local[size_class];
+                    free_block* b = lc.free_list;
+                    if(b == 0)
+                    {
+                        b = self.remote[size_class].exchange(0, memory_order_acquire);
+                    }
+                    if(b != 0)
+                    {
+                        lc.free_list = b->next;
+                        return b;
+                    }
+                    const std::size_t size = (size_class + 1) * pool_granularity;
+                    if(static_cast<std::size_t>(lc.bump_end - lc.bump) < size)
+                    {
+                        char* mem = static_cast<char*>(aligned_malloc(slab_size, slab_size));
+                        if(mem == 0)
+                        {
+                            throw std::bad_alloc();
+                        }
+                        slab_header* header = reinterpret_cast<slab_header*>(mem);
+                        header->owner = &self;
+                        header->size_class = size_class;
+                        lc.bump = mem + slab_header_size;
+                        lc.bump_end = mem + slab_size;
+                    }
+                    void* p = lc.bump;
+                    lc.bump += size;
+                    return p;
+                }
+
+                static void deallocate(void* p)
+                {
+                    slab_header* header = slab_of(p);
+                    thread_cache& self = cache();
+                    local_class& lc = self.local[header->size_class];
+                    free_block* b = static_cast<free_block*>(p);
+                    if(header->owner == &self)
+                    {
+                        b->next = lc.free_list;
+                        lc.free_list = b;
+                        return;
+                    }
+                    if(lc.pending_owner != header->owner)
+                    {
+                        flush(lc, header->size_class);
+                        lc.pending_owner = header->owner;
+                        lc.pending_tail = b;
+                    }
+                    b->next = lc.pending_head;
+                    lc.pending_head = b;
+                    if(++lc.pending_count >= remote_batch)
+                    {
+                        flush(lc, header->size_class);
+                    }
+                }
+
+                // hands a pending batch back to the cache owning it
+                static void flush(local_class& lc, std::size_t size_class)
+                {
+                    if(lc.pending_head != 0)
+                    {
+                        atomic<free_block*>& remote = lc.pending_owner->remote[size_class];
+                        free_block* head = remote.load(memory_order_relaxed);
+                        do
+                        {
+                            lc.pending_tail->next = head;
+                        }
+                        while(!remote.compare_exchange_weak(head, lc.pending_head, memory_order_release, memory_order_relaxed));
+                    }
+                    lc.pending_owner = 0;
+                    lc.pending_head = 0;
+                    lc.pending_tail = 0;
+                    lc.pending_count = 0;
+                }
+
+                static void flush_all(void)
+                {
+                    thread_cache* c = local.cache;
+                    if(c != 0)
+                    {
+                        for(std::size_t i = 0; i < class_count; ++i)
+                        {
+                            flush(c->local[i], i);
+                        }
+                    }
+                }
+
+                static void release(void)
+                {
+                    thread_cache* c = local.cache;
+                    if(c != 0)
+                    {
+                        flush_all();
+                        local.cache = 0;
+                        c->in_use.store(false, memory_order_release);
+                    }
+                }
+
+                // reuses the cache of a thread which exited, or creates a new one
+                static thread_cache* adopt(void)
+                {
+                    for(thread_cache* c = registry.load(memory_order_acquire); c != 0; c = c->next_cache)
+                    {
+                        bool expected = false;
+                        if(!c->in_use.load(memory_order_relaxed)
+                            && c->in_use.compare_exchange_strong(expected, true, memory_order_acquire, memory_order_relaxed))
+                        {
+                            return c;
+                        }
+                    }
+                    thread_cache* c = static_cast<thread_cache*>(aligned_malloc(sizeof(thread_cache), cache_line_size));
+                    if(c == 0)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    for(std::size_t i = 0; i < class_count; ++i)
+                    {
+                        local_class empty = { 0, 0, 0, 0, 0, 0, 0 };
+                        c->local[i] = empty;
+                        new (&c->remote[i]) atomic<free_block*>(static_cast<free_block*>(0));
+                    }
+                    new (&c->in_use) atomic<bool>(true);
+                    thread_cache* head = registry.load(memory_order_relaxed);
+                    do
+                    {
+                        c->next_cache = head;
+                    }
+                    while(!registry.compare_exchange_weak(head, c, memory_order_release, memory_order_relaxed));
+                    return c;
+                }
+            };
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            template<typename Dummy>
+            thread_local typename impl<Dummy>::cache_handle impl<Dummy>::local;
+#else
+            template<typename Dummy>
+            BOOST_UPTR_THREAD_LOCAL typename impl<Dummy>::cache_handle impl<Dummy>::local;
+#endif
+
+            template<typename Dummy>
+            atomic<thread_cache*> impl<Dummy>::registry;
+
+            // compile time size class selection
+            template<typename T>
+            struct size_class
+            {
+                // blocks are only aligned to pool_granularity
+                BOOST_STATIC_CONSTANT(bool, pooled = sizeof(T) <= pool_max_size
+                    && alignment_of<T>::value <= pool_granularity);
+                BOOST_STATIC_CONSTANT(std::size_t, value = (sizeof(T) + pool_granularity - 1) / pool_granularity - 1);
+            };
+
+            template<typename T>
+            inline void* allocate(true_type)
+            {
+                return impl<>::allocate(size_class<T>::value);
+            }
+
+            // aligned for every T, so pool_delete<T> can free blocks of any non-pooled U converting to T
+            template<typename T>
+            inline void* allocate(false_type)
+            {
+                const std::size_t align = alignment_of<T>::value > sizeof(void*) ? alignment_of<T>::value : sizeof(void*);
+                void* p = aligned_malloc(sizeof(T), align);
+                if(p == 0)
+                {
+                    throw std::bad_alloc();
+                }
+                return p;
+            }
+
+            inline void deallocate(void* p, true_type)
+            {
+                impl<>::deallocate(p);
+            }
+
+            inline void deallocate(void* p, false_type)
+            {
+                aligned_free(p);
+            }
+        }
+    }
+
+    /**
+     * Flushes blocks this thread freed on behalf of other threads back to their owners.
+     */
+    inline void flush_pool_thread_cache(void)
+    {
+        ::boost::uptr_detail::pool::impl<>::flush_all();
+    }
+
+    /**
+     * Flushes and gives this thread's cache back so another thread can reuse it.
+     * Happens automatically on thread exit when thread_local is available.
+     */
+    inline void release_pool_thread_cache(void)
+    {
+        ::boost::uptr_detail::pool::impl<>::release();
+    }
+
+    /**
+     * Deleter for objects created by make_unique_pooled.
+     */
+    template<class T>
+    struct pool_delete
+    {
+    private:
+        BOOST_STATIC_ASSERT_MSG(!is_array<T>::value, "pool_delete only supports single objects.");
+
+        // Used for testing if templated copy constructor can participate in overload resolution
+        struct nat
+        {
+        };
+
+        typedef integral_constant<bool, ::boost::uptr_detail::pool::size_class<T>::pooled> pooled;
+
+    public:
+        pool_delete(void)
+        {
+        }
+
+        // U must come from the same allocator (pool or system heap) as T
+        template<class U>
+        pool_delete(const pool_delete<U>&, typename enable_if_c<
+                is_convertible<U*, T*>::value
+                && ::boost::uptr_detail::pool::size_class<U>::pooled == ::boost::uptr_detail::pool::size_class<T>::pooled,
+                nat>::type = nat())
+        {
+        }
+
+        /**
+         * Destroys *ptr and returns its block to the pool
+         */
+        void operator()(T* ptr) const
+        {
+            void* block = ::boost::uptr_detail::block_of(ptr);
+            ptr->~T();
+            ::boost::uptr_detail::pool::deallocate(block, pooled());
+        }
+    };
+
+    namespace uptr_detail
+    {
+        template<typename T>
+        struct make_unique_pooled_switch
+        {
+            typedef ::boost::unique_ptr<T, ::boost::pool_delete<T> > single_object;
+        };
+
+        template<typename T>
+        struct make_unique_pooled_switch<T[]>
+        {
+        };
+
+        template<typename T, std::size_t N>
+        struct make_unique_pooled_switch<T[N]>
+        {
+        };
+
+        namespace pool
+        {
+            // returns the block to the pool if the constructor throws
+            template<typename T>
+            class construct_guard
+            {
+            public:
+                typedef integral_constant<bool, size_class<T>::pooled> pooled;
+
+                construct_guard(void) :
+                    block(allocate<T>(pooled()))
+                {
+                }
+
+                ~construct_guard(void)
+                {
+                    if(block != 0)
+                    {
+                        deallocate(block, pooled());
+                    }
+                }
+
+                T* release(T* p)
+                {
+                    block = 0;
+                    return p;
+                }
+
+                void* block;
+            };
+        }
+    }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    /**
+     * Equivalent to: unique_ptr<T, pool_delete<T> >(new (pool) T(std::forward<Args>(args)...));
+     */
+    template<typename T, typename... Args>
+    inline typename ::boost::uptr_detail::make_unique_pooled_switch<T>::single_object
+    make_unique_pooled(Args&&... args)
+    {
+        ::boost::uptr_detail::pool::construct_guard<T> guard;
+        return typename ::boost::uptr_detail::make_unique_pooled_switch<T>::single_object(
+            guard.release(new (guard.block) T(::boost::uptr_detail::forward<Args>(args)...)));
+    }
+#else
+    /**
+     * Equivalent to: unique_ptr<T, pool_delete<T> >(new (pool) T(a0, ..., an-1));
+     */
+#define BOOST_UPTR_MAKE_UNIQUE_POOLED(z, n, data) \
+    template<typename T BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+    inline typename ::boost::uptr_detail::make_unique_pooled_switch<T>::single_object \
+    make_unique_pooled(BOOST_UPTR_FWD_PARAMS(n)) \
+    { \
+        ::boost::uptr_detail::pool::construct_guard<T> guard; \
+        return typename ::boost::uptr_detail::make_unique_pooled_switch<T>::single_object( \
+            guard.release(new (guard.block) T(BOOST_UPTR_FWD_ARGS(n)))); \
+    }
+
+    BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_MAKE_UNIQUE_POOLED, ~)
+
+#undef BOOST_UPTR_MAKE_UNIQUE_POOLED
+#endif
+}
+
+#endif // BOOST_POOL_DELETE_HPP
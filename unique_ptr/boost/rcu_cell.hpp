@@ -0,0 +1,470 @@
+//
+// rcu_cell.hpp
+//
+// Read-mostly publication of immutable snapshots (configuration, routing tables) with epoch-based reclamation.
+//
+// rcu_cell<T, D> owns the current version of an object. Writers publish a new version with
+// update(unique_ptr<T, D>); readers look at the current one through a read guard:
+//
+//  boost::rcu_cell<const table> routes(boost::make_unique<const table>(...));
+//
+//  // reader
+//  boost::rcu_cell<const table>::read_ptr t = routes.read();
+//  t->lookup(key);                                 // t stays valid until the guard goes away
+//
+//  // writer
+//  routes.update(boost::make_unique<const table>(...));
+//
+// Entering a read section only writes to a record owned by the reading thread (its announced epoch), so
+// readers on different cores never write a shared cache line. Replaced versions are retired to a global
+// reclamation domain and passed to their original deleter once every reader which may still see them has
+// left its read section. Reclamation is attempted on every update and by rcu_reclaim().
+//
+// Read sections may nest and a guard may span reads of several cells. Updating from within a read section
+// is allowed, the replaced version is only reclaimed after the section ends.
+//
+// Reader records are recycled when a thread exits. Without C++11 thread_local there is no thread exit hook:
+// call release_rcu_reader() before a thread which read an rcu_cell exits.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_RCU_CELL_HPP
+#define BOOST_RCU_CELL_HPP
+
+#include <cstddef>
+#include <new>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_aligned.hpp>
+#include <boost/unique_ptr/detail/uptr_concurrency.hpp>
+#include <boost/unique_ptr/detail/uptr_reject_lvalue.hpp>
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        namespace rcu
+        {
+            // a version replaced by an update, destroyed once no reader can see it
+            struct retired
+            {
+                retired* next;
+                // epoch at the time it was unpublished
+                uint64_t epoch;
+                void (*destroy)(retired*);
+            };
+
+            template<class T, class D>
+            struct retired_version : retired
+            {
+                typedef typename unique_ptr<T, D>::pointer pointer;
+
+                retired_version(pointer p, const D& d) :
+                    p(p), d(d)
+                {
+                    destroy = &retired_version::destroy_version;
+                }
+
+                static void destroy_version(retired* r)
+                {
+                    retired_version* v = static_cast<retired_version*>(r);
+                    v->d(v->p);
+                    delete v;
+                }
+
+                pointer p;
+                D d;
+            };
+
+            // one per reading thread, on its own cache line
+            struct reader_record
+            {
+                // epoch announced by a thread in a read section, 0 outside
+                atomic<uint64_t> active;
+                // only touched by the owning thread
+                std::size_t nesting;
+                char pad[cache_line_size];
+                atomic<bool> in_use;
+                // registry link, never changes once the record is published
+                reader_record* next_record;
+            };
+
+            // statics are members of a class template so they are defined once across translation units
+            template<typename Dummy = void>
+            struct impl
+            {
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+                // gives the record back on thread exit
+                struct record_handle
+                {
+                    reader_record* record;
+
+                    ~record_handle(void)
+                    {
+                        impl::release();
+                    }
+                };
+                static thread_local record_handle local;
+#else
+                struct record_handle
+                {
+                    reader_record* record;
+                };
+                static BOOST_UPTR_THREAD_LOCAL record_handle local;
+#endif
+                // starts at 1, 0 means "not reading"
+                static atomic<uint64_t> global_epoch;
+                // every record ever created, records are never freed
+                static atomic<reader_record*> registry;
+                // versions waiting for readers to move on
+                static atomic<retired*> retired_list;
+
+                static reader_record& record(void)
+                {
+                    reader_record* r = local.record;
+                    if(r == 0)
+                    {
+                        r = adopt();
+                        local.record = r;
+                    }
+                    return *r;
+                }
+
+                static void enter(void)
+                {
+                    reader_record& r = record();
+                    if(r.nesting++ == 0)
+                    {
+                        // seq_cst orders the announcement before the reader loads any published pointer
+                        r.active.exchange(global_epoch.load(memory_order_acquire), memory_order_seq_cst);
+                    }
+                }
+
+                static void leave(void)
+                {
+                    reader_record& r = *local.record;
+                    if(--r.nesting == 0)
+                    {
+                        r.active.store(0, memory_order_release);
+                    }
+                }
+
+                static void retire(retired* r)
+                {
+                    // readers announcing a later epoch started after the version was unpublished
+                    r->epoch = global_epoch.fetch_add(1, memory_order_seq_cst);
+                    push(r, r);
+                }
+
+                static void push(retired* first, retired* last)
+                {
+                    retired* head = retired_list.load(memory_order_relaxed);
+                    do
+                    {
+                        last->next = head;
+                    }
+                    while(!retired_list.compare_exchange_weak(head, first, memory_order_release, memory_order_relaxed));
+                }
+
+                // destroys the versions no reader can see anymore, returns how many are still pending
+                static std::size_t reclaim(void)
+                {
+                    retired* list = retired_list.exchange(0, memory_order_acquire);
+                    if(list == 0)
+                    {
+                        return 0;
+                    }
+                    // oldest epoch any reader may still be looking at
+                    uint64_t oldest = static_cast<uint64_t>(-1);
+                    for(reader_record* r = registry.load(memory_order_acquire); r != 0; r = r->next_record)
+                    {
+                        const uint64_t e = r->active.load(memory_order_seq_cst);
+                        if(e != 0 && e < oldest)
+                        {
+                            oldest = e;
+                        }
+                    }
+                    retired* keep_first = 0;
+                    retired* keep_last = 0;
+                    std::size_t pending = 0;
+                    while(list != 0)
+                    {
+                        retired* r = list;
+                        list = list->next;
+                        if(r->epoch < oldest)
+                        {
+                            r->destroy(r);
+                        }
+                        else
+                        {
+                            r->next = keep_first;
+                            keep_first = r;
+                            keep_last = keep_last != 0 ? keep_last : r;
+                            ++pending;
+                        }
+                    }
+                    if(keep_first != 0)
+                    {
+                        push(keep_first, keep_last);
+                    }
+                    return pending;
+                }
+
+                static void release(void)
+                {
+                    reader_record* r = local.record;
+                    if(r != 0 && r->nesting == 0)
+                    {
+                        local.record = 0;
+                        r->in_use.store(false, memory_order_release);
+                    }
+                }
+
+                // reuses the record of a thread which exited, or creates a new one
+                static reader_record* adopt(void)
+                {
+                    for(reader_record* r = registry.load(memory_order_acquire); r != 0; r = r->next_record)
+                    {
+                        bool expected = false;
+                        if(!r->in_use.load(memory_order_relaxed)
+                            && r->in_use.compare_exchange_strong(expected, true, memory_order_acquire, memory_order_relaxed))
+                        {
+                            return r;
+                        }
+                    }
+                    reader_record* r = static_cast<reader_record*>(aligned_malloc(sizeof(reader_record), cache_line_size));
+                    if(r == 0)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    new (&r->active) atomic<uint64_t>(0);
+                    r->nesting = 0;
+                    new (&r->in_use) atomic<bool>(true);
+                    reader_record* head = registry.load(memory_order_relaxed);
+                    do
+                    {
+                        r->next_record = head;
+                    }
+                    while(!registry.compare_exchange_weak(head, r, memory_order_release, memory_order_relaxed));
+                    return r;
+                }
+            };
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            template<typename Dummy>
+            thread_local typename impl<Dummy>::record_handle impl<Dummy>::local;
+#else
+            template<typename Dummy>
+            BOOST_UPTR_THREAD_LOCAL typename impl<Dummy>::record_handle impl<Dummy>::local;
+#endif
+
+            template<typename Dummy>
+            atomic<uint64_t> impl<Dummy>::global_epoch(1);
+
+            template<typename Dummy>
+            atomic<reader_record*> impl<Dummy>::registry;
+
+            template<typename Dummy>
+            atomic<retired*> impl<Dummy>::retired_list;
+        }
+    }
+
+    /**
+     * Read section: versions seen by this thread while a guard exists are not destroyed.
+     */
+    class rcu_read_guard
+    {
+    public:
+        rcu_read_guard(void)
+        {
+            ::boost::uptr_detail::rcu::impl<>::enter();
+        }
+
+        rcu_read_guard(const rcu_read_guard&)
+        {
+            ::boost::uptr_detail::rcu::impl<>::enter();
+        }
+
+        ~rcu_read_guard(void)
+        {
+            ::boost::uptr_detail::rcu::impl<>::leave();
+        }
+
+    private:
+        rcu_read_guard& operator=(const rcu_read_guard&);
+    };
+
+    /**
+     * Destroys the retired versions no reader can see anymore. Returns the number still waiting for readers.
+     */
+    inline std::size_t rcu_reclaim(void)
+    {
+        return ::boost::uptr_detail::rcu::impl<>::reclaim();
+    }
+
+    /**
+     * Gives this thread's reader record back so another thread can reuse it.
+     * Happens automatically on thread exit when thread_local is available.
+     */
+    inline void release_rcu_reader(void)
+    {
+        ::boost::uptr_detail::rcu::impl<>::release();
+    }
+
+    template<class T, class D = default_delete<T> >
+    class rcu_cell
+    {
+        // not copyable or movable
+        rcu_cell(const rcu_cell&);
+        rcu_cell& operator=(const rcu_cell&);
+
+    public:
+        typedef unique_ptr<T, D> value_type;
+        typedef typename value_type::pointer pointer;
+        typedef typename value_type::element_type element_type;
+        typedef D deleter_type;
+
+        /**
+         * Read guard which also points at the version current when it was created.
+         * Copies share the version and extend the read section.
+         */
+        class read_ptr
+        {
+        public:
+            element_type& operator*(void) const
+            {
+                return *p;
+            }
+
+            pointer operator->(void) const
+            {
+                return p;
+            }
+
+            pointer get(void) const
+            {
+                return p;
+            }
+
+        private:
+            friend class rcu_cell;
+
+            explicit read_ptr(const ::boost::uptr_detail::atomic<pointer>& current) :
+                p(current.load(::boost::uptr_detail::memory_order_seq_cst))
+            {
+            }
+
+            rcu_read_guard guard;
+            pointer p;
+        };
+
+        rcu_cell(void) :
+            current(pointer()), writing(false)
+        {
+        }
+
+        /**
+         * Publishes u's object as the first version.
+         */
+        explicit rcu_cell(BOOST_RV_REF(value_type) u) :
+            current(u.get()), deleter(boost::move(u.get_deleter())), writing(false)
+        {
+            u.release();
+        }
+
+        /**
+         * Destroys the current version, nobody may be reading it anymore.
+         */
+        ~rcu_cell(void)
+        {
+            const pointer p = current.load(::boost::uptr_detail::memory_order_acquire);
+            if(p != pointer())
+            {
+                deleter(p);
+            }
+            rcu_reclaim();
+        }
+
+        /**
+         * Enters a read section and returns the current version (null if there is none).
+         */
+        read_ptr read(void) const
+        {
+            return read_ptr(current);
+        }
+
+        /**
+         * The current version. Only valid inside a read section (while an rcu_read_guard exists).
+         */
+        pointer load(void) const
+        {
+            return current.load(::boost::uptr_detail::memory_order_seq_cst);
+        }
+
+        /**
+         * Publishes u's object. The previous version is destroyed with its deleter once no reader can see it.
+         * Safe to call from several threads.
+         */
+        void update(BOOST_RV_REF(value_type) u)
+        {
+            typedef ::boost::uptr_detail::rcu::retired_version<T, D> retired_type;
+            value_type& next = static_cast<value_type&>(u);
+            lock();
+            const pointer old = current.load(::boost::uptr_detail::memory_order_relaxed);
+            retired_type* r = 0;
+            if(old != pointer())
+            {
+                try
+                {
+                    r = new retired_type(old, deleter);
+                }
+                catch(...)
+                {
+                    unlock();
+                    throw;
+                }
+            }
+            current.store(next.get(), ::boost::uptr_detail::memory_order_seq_cst);
+            deleter = boost::move(next.get_deleter());
+            next.release();
+            unlock();
+            if(r != 0)
+            {
+                ::boost::uptr_detail::rcu::impl<>::retire(r);
+            }
+            rcu_reclaim();
+        }
+
+    private:
+        explicit rcu_cell(value_type&) BOOST_UPTR_REJECT_LVALUE;
+        void update(value_type&) BOOST_UPTR_REJECT_LVALUE;
+
+        // serializes writers, readers never touch it
+        void lock(void)
+        {
+            while(writing.exchange(true, ::boost::uptr_detail::memory_order_acquire))
+            {
+                while(writing.load(::boost::uptr_detail::memory_order_relaxed))
+                {
+                }
+            }
+        }
+
+        void unlock(void)
+        {
+            writing.store(false, ::boost::uptr_detail::memory_order_release);
+        }
+
+        ::boost::uptr_detail::atomic<pointer> current;
+        char pad[::boost::uptr_detail::cache_line_size];
+        D deleter;
+        ::boost::uptr_detail::atomic<bool> writing;
+    };
+}
+
+#endif // BOOST_RCU_CELL_HPP
@@ -0,0 +1,142 @@
+//
+// relocate.hpp
+//
+// Relocation: moving objects to new storage and ending the lifetime of the originals in one step.
+// For trivially relocatable types this is a plain memcpy/memmove, no move constructor or destructor runs.
+//
+// is_trivially_relocatable<T> is true for scalars, trivially copyable types, references, default_delete
+// and unique_ptr<T, D> whose pointer and deleter are trivially relocatable.
+// Specialize it for other types which don't depend on their own address.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_RELOCATE_HPP
+#define BOOST_RELOCATE_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <boost/unique_ptr.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_reference.hpp>
+#include <boost/type_traits/is_scalar.hpp>
+
+namespace boost
+{
+    template<class T>
+    struct is_trivially_relocatable : integral_constant<bool, is_scalar<T>::value || is_reference<T>::value
+        || (has_trivial_copy<T>::value && has_trivial_destructor<T>::value)>
+    {
+    };
+
+    template<class T>
+    struct is_trivially_relocatable<const T> : is_trivially_relocatable<T>
+    {
+    };
+
+    template<class T>
+    struct is_trivially_relocatable<default_delete<T> > : true_type
+    {
+    };
+
+    template<class T, class D>
+    struct is_trivially_relocatable<unique_ptr<T, D> > : integral_constant<bool,
+        is_trivially_relocatable<typename unique_ptr<T, D>::pointer>::value && is_trivially_relocatable<D>::value>
+    {
+    };
+
+    namespace uptr_detail
+    {
+        template<class T, bool trivial = is_trivially_relocatable<T>::value>
+        struct relocator
+        {
+            // [first, first + n) and [dest, dest + n) may overlap
+            static void relocate(T* first, std::size_t n, T* dest)
+            {
+                if(n != 0)
+                {
+                    std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+                }
+            }
+
+            static void relocate_disjoint(T* first, std::size_t n, T* dest)
+            {
+                if(n != 0)
+                {
+                    std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+                }
+            }
+        };
+
+        template<class T>
+        struct relocator<T, false>
+        {
+            static void relocate_one(T* from, T* to)
+            {
+                ::new (static_cast<void*>(to)) T(::boost::move(*from));
+                from->~T();
+            }
+
+            static void relocate(T* first, std::size_t n, T* dest)
+            {
+                if(dest < first)
+                {
+                    for(std::size_t i = 0; i < n; ++i)
+                    {
+                        relocate_one(first + i, dest + i);
+                    }
+                }
+                else if(first < dest)
+                {
+                    for(std::size_t i = n; i > 0; --i)
+                    {
+                        relocate_one(first + i - 1, dest + i - 1);
+                    }
+                }
+            }
+
+            static void relocate_disjoint(T* first, std::size_t n, T* dest)
+            {
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    relocate_one(first + i, dest + i);
+                }
+            }
+        };
+    }
+
+    /**
+     * Relocates [first, last) into the uninitialized storage starting at dest. The ranges must not overlap.
+     * Afterwards [first, last) is uninitialized storage. Returns dest + (last - first).
+     * Types which aren't trivially relocatable are move constructed then destroyed; their move constructor
+     * must not throw.
+     */
+    template<class T>
+    inline T* uninitialized_relocate(T* first, T* last, T* dest)
+    {
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        ::boost::uptr_detail::relocator<T>::relocate_disjoint(first, n, dest);
+        return dest + n;
+    }
+
+    /**
+     * Relocates n objects starting at first to dest. The ranges may overlap (e.g. shifting elements within
+     * one buffer); slots of [dest, dest + n) outside of [first, first + n) must be uninitialized storage.
+     * Afterwards slots of [first, first + n) outside of [dest, dest + n) are uninitialized storage.
+     * Returns dest + n.
+     */
+    template<class T>
+    inline T* relocate_n(T* first, std::size_t n, T* dest)
+    {
+        ::boost::uptr_detail::relocator<T>::relocate(first, n, dest);
+        return dest + n;
+    }
+}
+
+#endif // BOOST_RELOCATE_HPP
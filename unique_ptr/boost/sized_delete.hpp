@@ -0,0 +1,261 @@
+//
+// sized_delete.hpp
+//
+// Deleters which pass the block size to ::operator delete (C++14 sized deallocation) so the allocator
+// doesn't have to look it up, paired with make_unique_sized<T>(args...) and make_unique_sized<T[]>(n).
+//
+// Memory is obtained with ::operator new and released with ::operator delete, so class specific
+// allocation functions are never used. Without sized deallocation support the unsized ::operator delete
+// is called instead.
+//
+// default_delete is unchanged: compilers supporting sized deallocation already pass the size for delete ptr.
+// sized_delete makes that explicit regardless of compiler flags, and for arrays carries the element count
+// (delete[] has to read it back from the allocation).
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SIZED_DELETE_HPP
+#define BOOST_SIZED_DELETE_HPP
+
+#include <cstddef>
+#include <new>
+#include <boost/config.hpp>
+#include <boost/make_unique.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/is_polymorphic.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/remove_extent.hpp>
+
+#if !defined(BOOST_UPTR_HAS_SIZED_DEALLOCATION)
+#if (defined(__cpp_sized_deallocation) && __cpp_sized_deallocation >= 201309L) \
+    || (defined(BOOST_MSVC) && BOOST_MSVC >= 1900)
+#define BOOST_UPTR_HAS_SIZED_DEALLOCATION
+#endif
+#endif
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        // strictest alignment ::operator new guarantees
+        union max_align
+        {
+            long double ld;
+            double d;
+            long l;
+            void* p;
+            void (*f)(void);
+        };
+
+        inline void sized_deallocate(void* p, std::size_t size)
+        {
+#if defined(BOOST_UPTR_HAS_SIZED_DEALLOCATION)
+            ::operator delete(p, size);
+#else
+            (void)size;
+            ::operator delete(p);
+#endif
+        }
+    }
+
+    /**
+     * Deleter for objects created by make_unique_sized<T>.
+     * Not convertible between types: the size passed to ::operator delete must be sizeof the allocated type.
+     */
+    template<class T>
+    struct sized_delete
+    {
+        /**
+         * Equivalent to: ptr->~T(); ::operator delete(ptr, sizeof(T));
+         */
+        void operator()(T* ptr) const
+        {
+            // checked here rather than at class scope so T may be incomplete where the owner is declared
+            BOOST_STATIC_ASSERT_MSG(!is_polymorphic<T>::value,
+                "sized_delete can't know the size of a derived object, use default_delete for polymorphic types.");
+            ptr->~T();
+            ::boost::uptr_detail::sized_deallocate(const_cast<void*>(static_cast<const volatile void*>(ptr)), sizeof(T));
+        }
+    };
+
+    // array specialization
+    // stores the element count, so there is no array cookie in the allocation
+    template<class T>
+    struct sized_delete<T[]>
+    {
+        sized_delete(void) :
+            count()
+        {
+        }
+
+        explicit sized_delete(std::size_t count) :
+            count(count)
+        {
+        }
+
+#if defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+    private:
+        // prevents deleting an array of U
+        template<class U> void operator()(U*) const;
+    public:
+#else
+        template<class U> void operator()(U*) const = delete;
+#endif
+
+        /**
+         * Destroys all elements in reverse order, then equivalent to: ::operator delete(ptr, size() * sizeof(T));
+         */
+        void operator()(T* ptr) const
+        {
+            if(!has_trivial_destructor<T>::value)
+            {
+                for(std::size_t i = count; i > 0; --i)
+                {
+                    ptr[i - 1].~T();
+                }
+            }
+            ::boost::uptr_detail::sized_deallocate(const_cast<void*>(static_cast<const volatile void*>(ptr)),
+                count * sizeof(T));
+        }
+
+        std::size_t size(void) const
+        {
+            return count;
+        }
+
+    private:
+        std::size_t count;
+    };
+
+    namespace uptr_detail
+    {
+        template<typename T>
+        struct make_unique_sized_switch
+        {
+            typedef ::boost::unique_ptr<T, ::boost::sized_delete<T> > single_object;
+        };
+
+        template<typename T>
+        struct make_unique_sized_switch<T[]>
+        {
+            typedef ::boost::unique_ptr<T[], ::boost::sized_delete<T[]> > unknown_bound;
+        };
+
+        template<typename T, std::size_t N>
+        struct make_unique_sized_switch<T[N]>
+        {
+            typedef void known_bound;
+        };
+
+        // gives the block back if the constructor throws
+        template<typename T>
+        class sized_construct_guard
+        {
+        public:
+            explicit sized_construct_guard(std::size_t size) :
+                block(::operator new(size)), size(size)
+            {
+                BOOST_STATIC_ASSERT_MSG(alignment_of<T>::value <= alignment_of<max_align>::value,
+                    "::operator new doesn't support over-aligned types.");
+            }
+
+            ~sized_construct_guard(void)
+            {
+                if(block != 0)
+                {
+                    sized_deallocate(block, size);
+                }
+            }
+
+            template<typename P>
+            P release(P p)
+            {
+                block = 0;
+                return p;
+            }
+
+            void* block;
+            std::size_t size;
+        };
+    }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    /**
+     * Equivalent to: unique_ptr<T, sized_delete<T> >(new (::operator new(sizeof(T))) T(std::forward<Args>(args)...));
+     */
+    template<typename T, typename... Args>
+    inline typename ::boost::uptr_detail::make_unique_sized_switch<T>::single_object
+    make_unique_sized(Args&&... args)
+    {
+        ::boost::uptr_detail::sized_construct_guard<T> guard(sizeof(T));
+        return typename ::boost::uptr_detail::make_unique_sized_switch<T>::single_object(
+            guard.release(new (guard.block) T(::boost::uptr_detail::forward<Args>(args)...)));
+    }
+#else
+    /**
+     * Equivalent to: unique_ptr<T, sized_delete<T> >(new (::operator new(sizeof(T))) T(a0, ..., an-1));
+     */
+#define BOOST_UPTR_MAKE_UNIQUE_SIZED(z, n, data) \
+    template<typename T BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)> \
+    inline typename ::boost::uptr_detail::make_unique_sized_switch<T>::single_object \
+    make_unique_sized(BOOST_UPTR_FWD_PARAMS(n)) \
+    { \
+        ::boost::uptr_detail::sized_construct_guard<T> guard(sizeof(T)); \
+        return typename ::boost::uptr_detail::make_unique_sized_switch<T>::single_object( \
+            guard.release(new (guard.block) T(BOOST_UPTR_FWD_ARGS(n)))); \
+    }
+
+    BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_MAKE_UNIQUE_SIZED, ~)
+
+#undef BOOST_UPTR_MAKE_UNIQUE_SIZED
+#endif
+
+    /**
+     * Array of n value-initialized elements, released with the size of the allocation.
+     */
+    template<typename T>
+    inline typename ::boost::uptr_detail::make_unique_sized_switch<T>::unknown_bound
+    make_unique_sized(std::size_t n)
+    {
+        typedef typename remove_cv<typename remove_extent<T>::type>::type element_type;
+        if(n > static_cast<std::size_t>(-1) / sizeof(element_type))
+        {
+            throw std::bad_alloc();
+        }
+        ::boost::uptr_detail::sized_construct_guard<element_type> guard(n * sizeof(element_type));
+        element_type* mem = static_cast<element_type*>(guard.block);
+        std::size_t i = 0;
+        try
+        {
+            for(; i < n; ++i)
+            {
+                new (mem + i) element_type();
+            }
+        }
+        catch(...)
+        {
+            for(; i > 0; --i)
+            {
+                mem[i - 1].~element_type();
+            }
+            throw;
+        }
+        return typename ::boost::uptr_detail::make_unique_sized_switch<T>::unknown_bound(
+            guard.release(mem), sized_delete<T>(n));
+    }
+
+    // arrays of known bound can't be created with make_unique_sized
+#if !defined(BOOST_NO_CXX11_DELETED_FUNCTIONS) && defined(BOOST_UPTR_VARIADIC_FACTORIES)
+    template<typename T, typename... Args>
+    typename ::boost::uptr_detail::make_unique_sized_switch<T>::known_bound
+    make_unique_sized(Args&&...) = delete;
+#endif
+}
+
+#endif // BOOST_SIZED_DELETE_HPP
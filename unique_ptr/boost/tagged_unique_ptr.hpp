@@ -0,0 +1,245 @@
+//
+// tagged_unique_ptr.hpp
+//
+// unique_ptr which keeps a few flag bits in the unused low bits of the owned pointer.
+//
+// tagged_unique_ptr<T, Bits, D> stores up to Bits tag bits next to the pointer, which must be no more than
+// log2(alignof(T)) bits. The tag is masked off before the pointer is returned by get(), operator->,
+// operator* and release() or passed to the deleter. With an empty deleter it is the size of a pointer:
+//
+//  struct node { boost::tagged_unique_ptr<node, 2> children[16]; };
+//  n.children[i].set_tag(leaf | dirty);
+//
+// The tag belongs to the slot rather than the object: release() and reset() keep it, a move copies it along.
+// Comparisons only look at the pointers.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TAGGED_UNIQUE_PTR_HPP
+#define BOOST_TAGGED_UNIQUE_PTR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/move/move.hpp>
+#include <boost/relocate.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/is_array.hpp>
+#include <boost/type_traits/is_reference.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_compressed_pair.hpp>
+#include <boost/unique_ptr/detail/uptr_reject_lvalue.hpp>
+
+namespace boost
+{
+    template<class T, std::size_t Bits, class D = default_delete<T> >
+    class tagged_unique_ptr
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(tagged_unique_ptr)
+
+        BOOST_STATIC_ASSERT_MSG(!is_array<T>::value, "tagged_unique_ptr doesn't support arrays.");
+        BOOST_STATIC_ASSERT_MSG(!is_reference<D>::value, "tagged_unique_ptr doesn't support reference deleters.");
+        BOOST_STATIC_ASSERT_MSG((is_same<typename unique_ptr<T, D>::pointer, T*>::value),
+            "tagged_unique_ptr needs a deleter taking T*.");
+        BOOST_STATIC_ASSERT_MSG(Bits < sizeof(uintptr_t) * 8, "Bits doesn't leave room for a pointer.");
+
+    public:
+        typedef T element_type;
+        typedef T* pointer;
+        typedef D deleter_type;
+        typedef uintptr_t tag_type;
+        typedef unique_ptr<T, D> unique_type;
+
+        BOOST_STATIC_CONSTANT(std::size_t, tag_bits = Bits);
+        BOOST_STATIC_CONSTANT(tag_type, tag_mask = (tag_type(1) << Bits) - 1);
+
+        tagged_unique_ptr(void) :
+            storage(0)
+        {
+        }
+
+        explicit tagged_unique_ptr(pointer p, tag_type tag = 0) :
+            storage(pack(p, tag))
+        {
+        }
+
+        tagged_unique_ptr(pointer p, tag_type tag, const D& d) :
+            storage(pack(p, tag), d)
+        {
+        }
+
+        /**
+         * Takes ownership of u's object and deleter.
+         */
+        explicit tagged_unique_ptr(BOOST_RV_REF(unique_type) u, tag_type tag = 0) :
+            storage(pack(static_cast<unique_type&>(u).get(), tag), boost::move(static_cast<unique_type&>(u).get_deleter()))
+        {
+            static_cast<unique_type&>(u).release();
+        }
+
+        tagged_unique_ptr(BOOST_RV_REF(tagged_unique_ptr) u) :
+            storage(u.storage.first(), boost::move(u.get_deleter()))
+        {
+            u.storage.first() &= tag_mask;
+        }
+
+        ~tagged_unique_ptr(void)
+        {
+            // checked here rather than at class scope so T may be incomplete where the member is declared
+            BOOST_STATIC_ASSERT_MSG((tag_type(1) << Bits) <= alignment_of<T>::value,
+                "The alignment of T doesn't leave Bits free bits.");
+            reset();
+        }
+
+        tagged_unique_ptr& operator=(BOOST_RV_REF(tagged_unique_ptr) u)
+        {
+            if(this != &u)
+            {
+                const tag_type tag = u.tag();
+                reset(u.release());
+                set_tag(tag);
+                storage.second() = boost::move(u.get_deleter());
+            }
+            return *this;
+        }
+
+        pointer get(void) const
+        {
+            return reinterpret_cast<pointer>(storage.first() & ~tag_mask);
+        }
+
+        tag_type tag(void) const
+        {
+            return storage.first() & tag_mask;
+        }
+
+        void set_tag(tag_type tag)
+        {
+            BOOST_ASSERT_MSG((tag & ~tag_mask) == 0, "tag doesn't fit in Bits bits");
+            storage.first() = (storage.first() & ~tag_mask) | tag;
+        }
+
+        D& get_deleter(void)
+        {
+            return storage.second();
+        }
+
+        const D& get_deleter(void) const
+        {
+            return storage.second();
+        }
+
+        T& operator*(void) const
+        {
+            return *get();
+        }
+
+        pointer operator->(void) const
+        {
+            return get();
+        }
+
+        /**
+         * Gives up ownership, keeping the tag. Returns the untagged pointer.
+         */
+        pointer release(void)
+        {
+            const pointer p = get();
+            storage.first() &= tag_mask;
+            return p;
+        }
+
+        /**
+         * Takes ownership of p, keeping the tag, and deletes the previously owned object.
+         */
+        void reset(pointer p = pointer())
+        {
+            const pointer old = get();
+            storage.first() = pack(p, tag());
+            if(old != pointer())
+            {
+                storage.second()(old);
+            }
+        }
+
+        void swap(tagged_unique_ptr& u)
+        {
+            using std::swap;
+            swap(storage.first(), u.storage.first());
+            swap(storage.second(), u.storage.second());
+        }
+
+#if defined(BOOST_NO_CXX11_EXPLICIT_CONVERSION_OPERATORS)
+        // safe bool idiom
+    private:
+        typedef void (*bool_type)();
+        static void this_type_does_not_support_comparisons()
+        {
+        }
+    public:
+        operator bool_type(void) const
+        {
+            return get() != pointer() ? &this_type_does_not_support_comparisons : 0;
+        }
+#else
+        explicit operator bool(void) const
+        {
+            return get() != pointer();
+        }
+#endif
+
+    private:
+        explicit tagged_unique_ptr(unique_type&, tag_type = 0) BOOST_UPTR_REJECT_LVALUE;
+
+        static tag_type pack(pointer p, tag_type tag)
+        {
+            const tag_type bits = reinterpret_cast<tag_type>(p);
+            BOOST_ASSERT_MSG((bits & tag_mask) == 0, "pointer isn't aligned to alignof(T)");
+            BOOST_ASSERT_MSG((tag & ~tag_mask) == 0, "tag doesn't fit in Bits bits");
+            return bits | tag;
+        }
+
+        ::boost::uptr_detail::compressed_pair<tag_type, D> storage;
+    };
+
+    template<class T, std::size_t Bits, class D>
+    inline void swap(tagged_unique_ptr<T, Bits, D>& a, tagged_unique_ptr<T, Bits, D>& b)
+    {
+        a.swap(b);
+    }
+
+    template<class T, std::size_t Bits, class D>
+    inline bool operator==(const tagged_unique_ptr<T, Bits, D>& a, const tagged_unique_ptr<T, Bits, D>& b)
+    {
+        return a.get() == b.get();
+    }
+
+    template<class T, std::size_t Bits, class D>
+    inline bool operator!=(const tagged_unique_ptr<T, Bits, D>& a, const tagged_unique_ptr<T, Bits, D>& b)
+    {
+        return a.get() != b.get();
+    }
+
+    template<class T, std::size_t Bits, class D>
+    inline bool operator<(const tagged_unique_ptr<T, Bits, D>& a, const tagged_unique_ptr<T, Bits, D>& b)
+    {
+        return a.get() < b.get();
+    }
+
+    // the tagged pointer is just an integer, so the owner can be moved bitwise if its deleter can
+    template<class T, std::size_t Bits, class D>
+    struct is_trivially_relocatable<tagged_unique_ptr<T, Bits, D> > :
+        is_trivially_relocatable<D>
+    {
+    };
+}
+
+#endif // BOOST_TAGGED_UNIQUE_PTR_HPP
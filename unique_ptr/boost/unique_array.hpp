@@ -0,0 +1,176 @@
+//
+// unique_array.hpp
+//
+// Owning dynamic array which knows its length: a unique_ptr<T[], D> whose deleter carries the element count.
+//
+// D must provide size(), e.g. sized_delete<T[]> (the default, which also frees the block with its size)
+// or arena_delete<T[]>. The count lives in the deleter, so a unique_array is two words.
+//
+// make_unique_array<T>(n) creates n value-initialized elements.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNIQUE_ARRAY_HPP
+#define BOOST_UNIQUE_ARRAY_HPP
+
+#include <cstddef>
+#include <boost/sized_delete.hpp>
+#include <boost/unique_ptr/detail/uptr_reject_lvalue.hpp>
+
+namespace boost
+{
+    template<class T, class D = sized_delete<T[]> >
+    class unique_array
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(unique_array)
+
+    public:
+        typedef unique_ptr<T[], D> owner_type;
+        typedef typename owner_type::pointer pointer;
+        typedef T element_type;
+        typedef D deleter_type;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef std::size_t size_type;
+
+        unique_array(void)
+        {
+        }
+
+        /**
+         * Takes ownership of p, d.size() elements long.
+         */
+        unique_array(pointer p, const D& d) :
+            owner(p, d)
+        {
+        }
+
+        /**
+         * Takes ownership of u's array, u.get_deleter().size() elements long.
+         */
+        unique_array(BOOST_RV_REF(owner_type) u) :
+            owner(boost::move(static_cast<owner_type&>(u)))
+        {
+        }
+
+        unique_array(BOOST_RV_REF(unique_array) a) :
+            owner(boost::move(a.owner))
+        {
+        }
+
+        unique_array& operator=(BOOST_RV_REF(unique_array) a)
+        {
+            owner = boost::move(a.owner);
+            return *this;
+        }
+
+        size_type size(void) const
+        {
+            return owner.get() != pointer() ? owner.get_deleter().size() : 0;
+        }
+
+        bool empty(void) const
+        {
+            return size() == 0;
+        }
+
+        T* data(void)
+        {
+            return owner.get();
+        }
+
+        const T* data(void) const
+        {
+            return owner.get();
+        }
+
+        iterator begin(void)
+        {
+            return data();
+        }
+
+        const_iterator begin(void) const
+        {
+            return data();
+        }
+
+        iterator end(void)
+        {
+            return data() + size();
+        }
+
+        const_iterator end(void) const
+        {
+            return data() + size();
+        }
+
+        T& operator[](size_type i)
+        {
+            return owner[i];
+        }
+
+        const T& operator[](size_type i) const
+        {
+            return owner[i];
+        }
+
+        pointer get(void) const
+        {
+            return owner.get();
+        }
+
+        D& get_deleter(void)
+        {
+            return owner.get_deleter();
+        }
+
+        const D& get_deleter(void) const
+        {
+            return owner.get_deleter();
+        }
+
+        /**
+         * Gives up ownership, the length is still available from get_deleter().size().
+         */
+        pointer release(void)
+        {
+            return owner.release();
+        }
+
+        void reset(void)
+        {
+            owner.reset();
+        }
+
+        void swap(unique_array& a)
+        {
+            owner.swap(a.owner);
+        }
+
+    private:
+        unique_array(owner_type&) BOOST_UPTR_REJECT_LVALUE;
+
+        owner_type owner;
+    };
+
+    template<class T, class D>
+    inline void swap(unique_array<T, D>& a, unique_array<T, D>& b)
+    {
+        a.swap(b);
+    }
+
+    /**
+     * Equivalent to: unique_array<T>(make_unique_sized<T[]>(n));
+     */
+    template<class T>
+    inline unique_array<T> make_unique_array(std::size_t n)
+    {
+        return unique_array<T>(make_unique_sized<T[]>(n));
+    }
+}
+
+#endif // BOOST_UNIQUE_ARRAY_HPP
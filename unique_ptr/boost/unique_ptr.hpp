@@ -21,8 +21,11 @@
 #if defined(BOOST_NO_CXX11_SMART_PTR)
 //#include <boost/move/move.hpp>
 #include <boost/static_assert.hpp>
-//#include <functional>
+#include <boost/functional/hash_fwd.hpp>
 //#include <boost/type_traits.hpp>
+#if !defined(BOOST_NO_CXX11_HDR_FUNCTIONAL)
+#include <functional>
+#endif
 #endif
 
 //#include <memory>
@@ -123,12 +126,33 @@ namespace boost
         {
            return x;
         }
+
+        // T is an rv bound to a const ref (a boost::move'd argument passed through BOOST_FWD_REF)
+        // forward as boost::rv
+        template <class T>
+        inline typename enable_if_c
+           < ::boost::move_detail::is_rv<T>::value, T&>::type
+               forward(const T& x) BOOST_NOEXCEPT
+        {
+           return const_cast<T&>(x);
+        }
+
+        // T is not an rv and not a lvalue ref, bound to a const ref (passed through BOOST_FWD_REF)
+        // forward as const T&
+        template <class T>
+        inline typename enable_if_c
+           < !is_lvalue_reference<T>::value && !::boost::move_detail::is_rv<T>::value, const T&>::type
+               forward(const T& x) BOOST_NOEXCEPT
+        {
+           return x;
+        }
 #else
         using std::forward;
 #endif
     }
 }
 
+#include <boost/unique_ptr/detail/uptr_compressed_pair.hpp>
 #include <boost/unique_ptr/detail/uptr_base.hpp>
 #include <boost/unique_ptr/detail/uptr_arrays.hpp>
 #include <boost/unique_ptr/detail/uptr_comparison.hpp>
@@ -0,0 +1,79 @@
+//
+// uptr_aligned.hpp
+//
+// Aligned raw allocation (posix_memalign or _aligned_malloc) and locating the start of an allocation
+// from a pointer which may refer to a base class subobject.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_ALIGNED_HPP
+#define BOOST_UPTR_ALIGNED_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <boost/config.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_polymorphic.hpp>
+
+#if defined(BOOST_WINDOWS)
+#include <malloc.h>
+#endif
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        // alignment ::operator new guarantees, larger ones need aligned_malloc
+#if defined(__STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        const std::size_t new_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else
+        const std::size_t new_alignment = alignment_of<long double>::value;
+#endif
+
+        // align must be a power of 2 and a multiple of sizeof(void*), returns 0 on failure
+        inline void* aligned_malloc(std::size_t size, std::size_t align)
+        {
+#if defined(BOOST_WINDOWS)
+            return _aligned_malloc(size, align);
+#else
+            void* mem = 0;
+            return posix_memalign(&mem, align, size) == 0 ? mem : 0;
+#endif
+        }
+
+        inline void aligned_free(void* p)
+        {
+#if defined(BOOST_WINDOWS)
+            _aligned_free(p);
+#else
+            std::free(p);
+#endif
+        }
+
+        template<typename T>
+        inline void* block_of(T* p, true_type)
+        {
+            return const_cast<void*>(dynamic_cast<const volatile void*>(p));
+        }
+
+        template<typename T>
+        inline void* block_of(T* p, false_type)
+        {
+            return const_cast<void*>(static_cast<const volatile void*>(p));
+        }
+
+        // start of the allocation holding *p, which for polymorphic types may be a base class subobject
+        template<typename T>
+        inline void* block_of(T* p)
+        {
+            return block_of(p, integral_constant<bool, is_polymorphic<T>::value>());
+        }
+    }
+}
+
+#endif // BOOST_UPTR_ALIGNED_HPP
@@ -36,45 +36,45 @@ namespace boost
         // No reference collapse rules in C++03, manually add it
         deleter_lref get_deleter(void)
         {
-            return del;
+            return storage.second();
         }
 
         // No reference collapse rules in C++03, manually add it
         const_deleter_lref get_deleter(void) const
         {
-            return del;
+            return storage.second();
         }
 #else
         D& get_deleter(void)
         {
-            return del;
+            return storage.second();
         }
 
         const D& get_deleter(void) const
         {
-            return del;
+            return storage.second();
         }
 #endif
 
         pointer release(void)
         {
-            pointer tmp = ptr;
-            ptr = BOOST_NULLPTR;
+            pointer tmp = storage.first();
+            storage.first() = BOOST_NULLPTR;
             return tmp;
         }
 
         pointer get(void) const
         {
-            return ptr;
+            return storage.first();
         }
 
         void reset(pointer p = pointer())
         {
-            pointer old_ptr = ptr;
-            ptr = p;
+            pointer old_ptr = storage.first();
+            storage.first() = p;
             if (old_ptr != BOOST_NULLPTR)
             {
-                del(old_ptr);
+                storage.second()(old_ptr);
             }
         }
 
@@ -85,8 +85,8 @@ namespace boost
             if(this != &other)
             {
                 using std::swap;
-                swap(ptr, other.ptr);
-                swap(del, other.del);
+                swap(storage.first(), other.storage.first());
+                swap(storage.second(), other.storage.second());
             }
         }
 
@@ -97,8 +97,8 @@ namespace boost
             {
                 using std::swap;
                 // forward is already inside of swap
-                swap(ptr, other.ptr);
-                swap(del, other.del);
+                swap(storage.first(), other.storage.first());
+                swap(storage.second(), other.storage.second());
             }
         }
 #endif
@@ -116,7 +116,7 @@ namespace boost
 
         T& operator[](size_t i) const
         {
-            return ptr[i];
+            return storage.first()[i];
         }
 
 #if defined(BOOST_NO_CXX11_EXPLICIT_CONVERSION_OPERATORS)
@@ -128,19 +128,19 @@ namespace boost
     public:
         operator bool_type(void) const
         {
-            return (ptr != BOOST_NULLPTR) ?
+            return (storage.first() != BOOST_NULLPTR) ?
             (&this_type_does_not_support_comparisons) :
             BOOST_NULLPTR;
         }
 #else
         explicit operator bool(void) const
         {
-            return ptr != BOOST_NULLPTR;
+            return storage.first() != BOOST_NULLPTR;
         }
 #endif
 
         unique_ptr(void) :
-            ptr(), del()
+            storage()
         {
             // if D is a reference or pointer type this is ill-formed
             BOOST_STATIC_ASSERT_MSG(
@@ -151,7 +151,7 @@ namespace boost
 #if defined(BOOST_NO_CXX11_NULLPTR)
         template<typename U>
         unique_ptr(BOOST_NULLPTR_TYPE, typename enable_if_c< !is_pointer<pointer>::value && is_same<U, U>::value, nat >::type = nat()) :
-            ptr(), del()
+            storage()
         {
             // if D is a reference or pointer type this is ill-formed
             BOOST_STATIC_ASSERT_MSG(
@@ -160,7 +160,7 @@ namespace boost
         }
 #else
         unique_ptr(BOOST_NULLPTR_TYPE) :
-            ptr(), del()
+            storage()
         {
             // if D is a reference or pointer type this is ill-formed
             BOOST_STATIC_ASSERT_MSG(
@@ -170,7 +170,7 @@ namespace boost
 #endif
 
         explicit unique_ptr(pointer ptr) :
-            ptr(ptr), del()
+            storage(ptr)
         {
             // if D is a reference or pointer type this is ill-formed
             BOOST_STATIC_ASSERT_MSG(
@@ -183,7 +183,7 @@ namespace boost
         unique_ptr(pointer ptr,
             typename conditional< is_reference<D>::value, D,
             const typename remove_reference<D>::type& >::type d1) :
-        ptr(ptr), del(d1)
+        storage(ptr, d1)
         {
         }
 //#else
@@ -196,7 +196,7 @@ namespace boost
 //#endif
         unique_ptr(pointer ptr,
             BOOST_RV_REF(typename remove_reference<D>::type) d2) :
-        ptr(ptr), del(boost::move(d2))
+        storage(ptr, boost::move(d2))
         {
             BOOST_STATIC_ASSERT_MSG( !is_reference<D>::value, "cannot instantiate D& with rvalue deleter" );
         }
@@ -204,7 +204,7 @@ namespace boost
 #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
         // needed to satsify factory constructor
         // TODO: problems if D is a reference.
-        unique_ptr(BOOST_RV_REF(unique_ptr) u) : ptr(u.release()), del(::boost::uptr_detail::forward<D>(u.del))
+        unique_ptr(BOOST_RV_REF(unique_ptr) u) : storage(u.release(), ::boost::uptr_detail::forward<D>(u.storage.second()))
         {
         }
 
@@ -230,7 +230,7 @@ namespace boost
         unique_ptr(BOOST_RV_REF_BEG unique_ptr<U, E> BOOST_RV_REF_END u, typename enable_if_c<
             is_convertible<typename boost::unique_ptr<U, E>::pointer, pointer>::value
             && is_array<U>::value && !is_reference<D>::value
-            && is_convertible<E, D>::value, nat>::type = nat()) : ptr(u.release()), del(boost::move(u.del))
+            && is_convertible<E, D>::value, nat>::type = nat()) : storage(u.release(), boost::move(u.storage.second()))
         {
         }
 
@@ -242,7 +242,7 @@ namespace boost
         unique_ptr(BOOST_RV_REF_BEG unique_ptr<U, E&> BOOST_RV_REF_END u, typename enable_if_c<
             is_convertible<typename boost::unique_ptr<U, E&>::pointer, pointer>::value
             && is_array<U>::value && is_reference<D>::value
-            && is_same<D, E&>::value, nat>::type = nat()) : ptr(u.release()), del(u.del)
+            && is_same<D, E&>::value, nat>::type = nat()) : storage(u.release(), u.storage.second())
         {
         }
 
@@ -254,7 +254,7 @@ namespace boost
         unique_ptr(BOOST_RV_REF_BEG unique_ptr<U, E&> BOOST_RV_REF_END u, typename enable_if_c<
             is_convertible<typename boost::unique_ptr<U, E&>::pointer, pointer>::value
             && is_array<U>::value && !is_reference<D>::value
-            && is_convertible<E&, D>::value, nat>::type = nat()) : ptr(u.release()), del(u.del)
+            && is_convertible<E&, D>::value, nat>::type = nat()) : storage(u.release(), u.storage.second())
         {
         }
 //#else
@@ -262,7 +262,7 @@ namespace boost
 //#endif // BOOST_NO_CXX11_FUNCTION_TEMPLATE_DEFAULT_ARGS
 #else
         unique_ptr(unique_ptr&& u) :
-            ptr(std::move(u.release())), del(std::forward < D > (u.del))
+            storage(u.release(), std::forward < D > (u.storage.second()))
         {
         }
 
@@ -274,7 +274,7 @@ namespace boost
             is_convertible< typename unique_ptr<U, E>::pointer, pointer>::value &&
             is_array<U>::value &&
             (is_reference<D>::value ? is_same<D, E>::value : is_convertible<E, D>::value), nat>::type = nat() ) :
-            ptr(std::move(u.release())), del(std::forward < E > (u.del))
+            storage(u.release(), std::forward < E > (u.storage.second()))
         {
         }
 
@@ -283,15 +283,15 @@ namespace boost
         //      and D = default_delete<T>
         template<typename U>
         unique_ptr(BOOST_RV_REF(std::auto_ptr<U>) u) :
-        ptr(u.release()), del()
+        storage(u.release())
         {
         }
 #endif // BOOST_NO_CXX11_RVALUE_REFERENCES
         ~unique_ptr(void)
         {
-            if (ptr != BOOST_NULLPTR)
+            if (storage.first() != BOOST_NULLPTR)
             {
-                del(ptr);
+                storage.second()(storage.first());
             }
         }
 
@@ -303,7 +303,7 @@ namespace boost
             if(this != &r)
             {
                 reset(r.release());
-                del = boost::uptr_detail::forward<D>(r.del);
+                storage.second() = boost::uptr_detail::forward<D>(r.storage.second());
 //                if(is_reference<D>::value)
 //                {
 //                    // copy assign
@@ -328,7 +328,7 @@ namespace boost
         operator=(BOOST_RV_REF_BEG unique_ptr<U, E> BOOST_RV_REF_END r)
         {
             reset(r.release());
-            del = boost::move(r.del);
+            storage.second() = boost::move(r.storage.second());
             return *this;
         }
 
@@ -342,7 +342,7 @@ namespace boost
         operator=(BOOST_RV_REF_BEG unique_ptr<U, E&> BOOST_RV_REF_END r)
         {
             reset(r.release());
-            del = r.del;
+            storage.second() = r.storage.second();
             return *this;
         }
 
@@ -353,7 +353,7 @@ namespace boost
             {
                 reset(r.release());
                 // forward deleter
-                del = std::forward < D > (r.del);
+                storage.second() = std::forward < D > (r.storage.second());
             }
             return *this;
         }
@@ -369,7 +369,7 @@ namespace boost
         {
             reset(r.release());
             // forward deleter
-            del = std::forward < E > (r.del);
+            storage.second() = std::forward < E > (r.storage.second());
             return *this;
         }
 #endif
@@ -381,8 +381,7 @@ namespace boost
         }
 
     private:
-        pointer ptr;
-        D del;
+        ::boost::uptr_detail::compressed_pair<pointer, D> storage;
 
         template<typename U, typename E>
         friend class unique_ptr;
@@ -36,45 +36,45 @@ namespace boost
         // No reference collapse rules in C++03, manually add it
         deleter_lref get_deleter(void)
         {
-            return del;
+            return storage.second();
         }
 
         // No reference collapse rules in C++03, manually add it
         const_deleter_lref get_deleter(void) const
         {
-            return del;
+            return storage.second();
         }
 #else
         D& get_deleter(void)
         {
-            return del;
+            return storage.second();
         }
 
         const deleter_type& get_deleter(void) const
         {
-            return del;
+            return storage.second();
         }
 #endif
 
         pointer release(void)
         {
-            pointer tmp = ptr;
-            ptr = BOOST_NULLPTR;
+            pointer tmp = storage.first();
+            storage.first() = BOOST_NULLPTR;
             return tmp;
         }
 
         pointer get(void) const
         {
-            return ptr;
+            return storage.first();
         }
 
         void reset(pointer p = pointer())
         {
-            pointer old_ptr = ptr;
-            ptr = p;
+            pointer old_ptr = storage.first();
+            storage.first() = p;
             if (old_ptr != BOOST_NULLPTR)
             {
-                del(old_ptr);
+                storage.second()(old_ptr);
             }
         }
 
@@ -85,8 +85,8 @@ namespace boost
             if(this != &other)
             {
                 using std::swap;
-                swap(ptr, other.ptr);
-                swap(del, other.del);
+                swap(storage.first(), other.storage.first());
+                swap(storage.second(), other.storage.second());
             }
         }
 #else
@@ -96,20 +96,20 @@ namespace boost
             {
                 using std::swap;
                 // forward is already inside of swap
-                swap(ptr, other.ptr);
-                swap(del, other.del);
+                swap(storage.first(), other.storage.first());
+                swap(storage.second(), other.storage.second());
             }
         }
 #endif
 
         typename add_lvalue_reference<T>::type operator*(void) const
         {
-            return *ptr;
+            return *storage.first();
         }
 
         pointer operator->(void) const
         {
-            return ptr;
+            return storage.first();
         }
 
 #if defined(BOOST_NO_CXX11_EXPLICIT_CONVERSION_OPERATORS)
@@ -122,19 +122,19 @@ namespace boost
     public:
         operator bool_type(void) const
         {
-            return (ptr != BOOST_NULLPTR) ?
+            return (storage.first() != BOOST_NULLPTR) ?
             (&this_type_does_not_support_comparisons) :
             BOOST_NULLPTR;
         }
 #else
         explicit operator bool(void) const
         {
-            return ptr != BOOST_NULLPTR;
+            return storage.first() != BOOST_NULLPTR;
         }
 #endif
 
         unique_ptr(void) :
-            ptr(), del()
+            storage()
         {
             // if D is a reference or pointer type this is ill-formed
             BOOST_STATIC_ASSERT_MSG(
@@ -145,7 +145,7 @@ namespace boost
 #if defined(BOOST_NO_CXX11_NULLPTR)
         template<typename U>
         unique_ptr(BOOST_NULLPTR_TYPE, typename enable_if_c< !is_pointer<pointer>::value && is_same<U, U>::value, nat >::type = nat()) :
-            ptr(), del()
+            storage()
         {
             // if D is a reference or pointer type this is ill-formed
             BOOST_STATIC_ASSERT_MSG(
@@ -154,7 +154,7 @@ namespace boost
         }
 #else
         unique_ptr(BOOST_NULLPTR_TYPE) :
-            ptr(), del()
+            storage()
         {
             // if D is a reference or pointer type this is ill-formed
             BOOST_STATIC_ASSERT_MSG(
@@ -164,7 +164,7 @@ namespace boost
 #endif
 
         explicit unique_ptr(pointer ptr) :
-            ptr(ptr), del()
+            storage(ptr)
         {
             // if D is a reference or pointer type this is ill-formed
             BOOST_STATIC_ASSERT_MSG(
@@ -177,7 +177,7 @@ namespace boost
         unique_ptr(pointer ptr,
             typename conditional< is_reference<D>::value, D,
             const typename remove_reference<D>::type& >::type d1) :
-        ptr(ptr), del(d1)
+        storage(ptr, d1)
         {
         }
 //#else
@@ -190,14 +190,14 @@ namespace boost
 //#endif
         unique_ptr(pointer ptr,
             BOOST_RV_REF(typename remove_reference<D>::type) d2) :
-        ptr(ptr), del(boost::move(d2))
+        storage(ptr, boost::move(d2))
         {
             BOOST_STATIC_ASSERT_MSG( !is_reference<D>::value, "cannot instantiate D& with rvalue deleter" );
         }
 
 #if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
         // needed to satisfy factory constructor
-        unique_ptr(BOOST_RV_REF_BEG unique_ptr BOOST_RV_REF_END u) : ptr(u.release()), del(::boost::uptr_detail::forward<D>(u.del))
+        unique_ptr(BOOST_RV_REF_BEG unique_ptr BOOST_RV_REF_END u) : storage(u.release(), ::boost::uptr_detail::forward<D>(u.storage.second()))
         {
         }
 
@@ -224,7 +224,7 @@ namespace boost
         unique_ptr(BOOST_RV_REF_BEG unique_ptr<U, E> BOOST_RV_REF_END u, typename enable_if_c<
             is_convertible<typename boost::unique_ptr<U, E>::pointer, pointer>::value
             && !is_array<U>::value && !is_reference<D>::value
-            && is_convertible<E, D>::value, nat>::type = nat()) : ptr(u.release()), del(boost::move(u.del))
+            && is_convertible<E, D>::value, nat>::type = nat()) : storage(u.release(), boost::move(u.storage.second()))
         {
         }
 
@@ -236,7 +236,7 @@ namespace boost
         unique_ptr(BOOST_RV_REF_BEG unique_ptr<U, E&> BOOST_RV_REF_END u, typename enable_if_c<
             is_convertible<typename boost::unique_ptr<U, E&>::pointer, pointer>::value
             && !is_array<U>::value && is_reference<D>::value
-            && is_same<D, E&>::value, nat>::type = nat()) : ptr(u.release()), del(u.del)
+            && is_same<D, E&>::value, nat>::type = nat()) : storage(u.release(), u.storage.second())
         {
         }
 
@@ -249,7 +249,7 @@ namespace boost
         unique_ptr(BOOST_RV_REF_BEG unique_ptr<U, E&> BOOST_RV_REF_END u, typename enable_if_c<
             is_convertible<typename boost::unique_ptr<U, E&>::pointer, pointer>::value
             && !is_array<U>::value && !is_reference<D>::value
-            && is_convertible<E&, D>::value, nat>::type = nat()) : ptr(u.release()), del(u.del)
+            && is_convertible<E&, D>::value, nat>::type = nat()) : storage(u.release(), u.storage.second())
         {
         }
 //#else
@@ -257,7 +257,7 @@ namespace boost
 //#endif // BOOST_NO_CXX11_FUNCTION_TEMPLATE_DEFAULT_ARGS
 #else
         unique_ptr(unique_ptr&& u) :
-            ptr(std::move(u.release())), del(std::forward < D > (u.del))
+            storage(u.release(), std::forward < D > (u.storage.second()))
         {
         }
 
@@ -269,7 +269,7 @@ namespace boost
             is_convertible< typename unique_ptr<U, E>::pointer, pointer>::value &&
             !is_array<U>::value &&
             (is_reference<D>::value ? is_same<D, E>::value : is_convertible<E, D>::value), nat>::type = nat() ) :
-            ptr(std::move(u.release())), del(std::forward < E > (u.del))
+            storage(u.release(), std::forward < E > (u.storage.second()))
         {
         }
 
@@ -278,15 +278,15 @@ namespace boost
         //      and D = default_delete<T>
         template<typename U>
         unique_ptr(BOOST_RV_REF(std::auto_ptr<U>) u) :
-        ptr(u.release()), del()
+        storage(u.release())
         {
         }
 #endif // BOOST_NO_CXX11_RVALUE_REFERENCES
         ~unique_ptr(void)
         {
-            if (ptr != BOOST_NULLPTR)
+            if (storage.first() != BOOST_NULLPTR)
             {
-                del(ptr);
+                storage.second()(storage.first());
             }
         }
 
@@ -298,7 +298,7 @@ namespace boost
             if(this != &r)
             {
                 reset(r.release());
-                del = boost::uptr_detail::forward<D>(r.del);
+                storage.second() = boost::uptr_detail::forward<D>(r.storage.second());
 //                if(is_reference<D>::value)
 //                {
 //                    // copy assign
@@ -323,7 +323,7 @@ namespace boost
         operator=(BOOST_RV_REF_BEG unique_ptr<U, E> BOOST_RV_REF_END r)
         {
             reset(r.release());
-            del = boost::move(r.del);
+            storage.second() = boost::move(r.storage.second());
             return *this;
         }
 
@@ -337,7 +337,7 @@ namespace boost
         operator=(BOOST_RV_REF_BEG unique_ptr<U, E&> BOOST_RV_REF_END r)
         {
             reset(r.release());
-            del = r.del;
+            storage.second() = r.storage.second();
             return *this;
         }
 
@@ -348,7 +348,7 @@ namespace boost
             {
                 reset(r.release());
                 // forward deleter
-                del = std::forward < deleter_type > (r.del);
+                storage.second() = std::forward < deleter_type > (r.storage.second());
             }
             return *this;
         }
@@ -364,7 +364,7 @@ namespace boost
         {
             reset(r.release());
             // forward deleter
-            del = std::forward < E > (r.del);
+            storage.second() = std::forward < E > (r.storage.second());
             return *this;
         }
 #endif
@@ -379,8 +379,7 @@ namespace boost
         }
 
     private:
-        pointer ptr;
-        deleter_type del;
+        ::boost::uptr_detail::compressed_pair<pointer, deleter_type> storage;
     };
 
     template<typename T, typename D>
@@ -404,6 +403,33 @@ namespace std
     }
 }
 #endif
-// TODO: std::hash specialization? There really isn't a std::hash implementation in C++03...
+
+// hashing hashes get(), like std::hash<std::unique_ptr>
+namespace boost
+{
+    // found by boost::hash through ADL
+    template<typename T, typename D>
+    inline std::size_t hash_value(const unique_ptr<T, D>& p)
+    {
+        return ::boost::hash<typename unique_ptr<T, D>::pointer>()(p.get());
+    }
+}
+
+#if !defined(BOOST_NO_CXX11_HDR_FUNCTIONAL)
+namespace std
+{
+    template<typename T, typename D>
+    struct hash<boost::unique_ptr<T, D> >
+    {
+        typedef boost::unique_ptr<T, D> argument_type;
+        typedef std::size_t result_type;
+
+        std::size_t operator()(const boost::unique_ptr<T, D>& p) const
+        {
+            return std::hash<typename boost::unique_ptr<T, D>::pointer>()(p.get());
+        }
+    };
+}
+#endif
 
 #endif // BOOST_UPTR_BASE_HPP
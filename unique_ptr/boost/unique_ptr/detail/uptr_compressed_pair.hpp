@@ -0,0 +1,185 @@
+//
+// uptr_compressed_pair.hpp
+//
+// Storage for the pointer/deleter pair held by unique_ptr.
+// Empty class deleters are stored as a base class so they take up no space (empty base optimization),
+// so sizeof(unique_ptr<T>) == sizeof(T*) when using default_delete. Final classes can't be derived from
+// and are stored as a member.
+//
+// Also used by other owners in this library (unique_resource), so it doesn't depend on the emulation.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_COMPRESSED_PAIR_HPP
+#define BOOST_UPTR_COMPRESSED_PAIR_HPP
+
+#include <boost/config.hpp>
+#include <boost/type_traits/add_const.hpp>
+#include <boost/type_traits/add_reference.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_empty.hpp>
+#include <boost/type_traits/is_final.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#include <utility>
+#endif
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        // true if D can be stored as an empty base class. is_empty derives from D when there is no
+        // compiler intrinsic, so it's only asked about classes which aren't final
+        template<typename D, bool = is_final<D>::value>
+        struct is_empty_base : is_empty<D>
+        {
+        };
+
+        template<typename D>
+        struct is_empty_base<D, true> : false_type
+        {
+        };
+
+        // reference, pointer and function pointer deleters are never empty classes,
+        // so they are always stored as a plain member
+        template<typename P, typename D, bool = is_empty_base<D>::value>
+        class compressed_pair;
+
+        // D is not empty (or is final): store both members
+        template<typename P, typename D>
+        class compressed_pair<P, D, false>
+        {
+        public:
+            typedef typename add_reference<D>::type second_reference;
+            typedef typename add_reference<typename add_const<D>::type>::type second_const_reference;
+
+            compressed_pair(void) :
+                p(), d()
+            {
+            }
+
+            explicit compressed_pair(P p) :
+                p(p), d()
+            {
+            }
+
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+            // Move emulation hands deleters around as lvalues (boost::rv<E>&),
+            // so taking E& is enough to pick the right constructor of D
+            template<typename E>
+            compressed_pair(P p, E& d) :
+                p(p), d(d)
+            {
+            }
+
+            template<typename E>
+            compressed_pair(P p, const E& d) :
+                p(p), d(d)
+            {
+            }
+#else
+            template<typename E>
+            compressed_pair(P p, E&& d) :
+                p(p), d(std::forward<E>(d))
+            {
+            }
+#endif
+
+            P& first(void)
+            {
+                return p;
+            }
+
+            const P& first(void) const
+            {
+                return p;
+            }
+
+            second_reference second(void)
+            {
+                return d;
+            }
+
+            second_const_reference second(void) const
+            {
+                return d;
+            }
+
+        private:
+            P p;
+            D d;
+        };
+
+        // D is an empty class: derive from it so it takes up no storage
+        template<typename P, typename D>
+        class compressed_pair<P, D, true> : private remove_cv<D>::type
+        {
+            typedef typename remove_cv<D>::type base_type;
+        public:
+            typedef typename add_reference<D>::type second_reference;
+            typedef typename add_reference<typename add_const<D>::type>::type second_const_reference;
+
+            compressed_pair(void) :
+                base_type(), p()
+            {
+            }
+
+            explicit compressed_pair(P p) :
+                base_type(), p(p)
+            {
+            }
+
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+            // Move emulation hands deleters around as lvalues (boost::rv<E>&),
+            // so taking E& is enough to pick the right constructor of D
+            template<typename E>
+            compressed_pair(P p, E& d) :
+                base_type(d), p(p)
+            {
+            }
+
+            template<typename E>
+            compressed_pair(P p, const E& d) :
+                base_type(d), p(p)
+            {
+            }
+#else
+            template<typename E>
+            compressed_pair(P p, E&& d) :
+                base_type(std::forward<E>(d)), p(p)
+            {
+            }
+#endif
+
+            P& first(void)
+            {
+                return p;
+            }
+
+            const P& first(void) const
+            {
+                return p;
+            }
+
+            second_reference second(void)
+            {
+                return static_cast<second_reference>(*this);
+            }
+
+            second_const_reference second(void) const
+            {
+                return static_cast<second_const_reference>(*this);
+            }
+
+        private:
+            P p;
+        };
+    }
+}
+
+#endif // BOOST_UPTR_COMPRESSED_PAIR_HPP
@@ -0,0 +1,62 @@
+//
+// uptr_concurrency.hpp
+//
+// Atomics and thread local storage shared by the concurrent deleters and owners.
+// Maps to <atomic> and thread_local when available, otherwise to Boost.Atomic and compiler specific
+// thread local storage.
+//
+// BOOST_UPTR_THREAD_LOCAL can only be applied to POD types (C++03 compiler extensions can't run
+// constructors or destructors of thread local objects).
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_CONCURRENCY_HPP
+#define BOOST_UPTR_CONCURRENCY_HPP
+
+#include <cstddef>
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+#include <atomic>
+#else
+#include <boost/atomic.hpp>
+#endif
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+#define BOOST_UPTR_THREAD_LOCAL thread_local
+#elif defined(BOOST_MSVC)
+#define BOOST_UPTR_THREAD_LOCAL __declspec(thread)
+#else
+#define BOOST_UPTR_THREAD_LOCAL __thread
+#endif
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+        using std::atomic;
+        using std::memory_order_relaxed;
+        using std::memory_order_acquire;
+        using std::memory_order_release;
+        using std::memory_order_acq_rel;
+        using std::memory_order_seq_cst;
+#else
+        using ::boost::atomic;
+        using ::boost::memory_order_relaxed;
+        using ::boost::memory_order_acquire;
+        using ::boost::memory_order_release;
+        using ::boost::memory_order_acq_rel;
+        using ::boost::memory_order_seq_cst;
+#endif
+
+        // padding used to keep independently written data on separate cache lines
+        const std::size_t cache_line_size = 64;
+    }
+}
+
+#endif // BOOST_UPTR_CONCURRENCY_HPP
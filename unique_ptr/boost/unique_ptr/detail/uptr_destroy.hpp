@@ -0,0 +1,37 @@
+//
+// uptr_destroy.hpp
+//
+// Type-erased destroy functions, for deleters which queue objects of any type for later destruction.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_DESTROY_HPP
+#define BOOST_UPTR_DESTROY_HPP
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+        typedef void (*destroy_function)(void*);
+
+        // equivalent to: delete static_cast<T*>(ptr);
+        template<typename T>
+        void destroy_object(void* ptr)
+        {
+            delete static_cast<T*>(ptr);
+        }
+
+        // equivalent to: delete[] static_cast<T*>(ptr);
+        template<typename T>
+        void destroy_array(void* ptr)
+        {
+            delete[] static_cast<T*>(ptr);
+        }
+    }
+}
+
+#endif // BOOST_UPTR_DESTROY_HPP
@@ -0,0 +1,63 @@
+//
+// uptr_factory.hpp
+//
+// Argument forwarding shared by the make_unique family of factories.
+//
+// With variadic templates and rvalue references BOOST_UPTR_VARIADIC_FACTORIES is defined.
+// Otherwise factories are generated for 0 to BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY arguments with
+// BOOST_PP_REPEAT using:
+//
+//  BOOST_UPTR_FWD_TEMPLATE_PARAMS(n)   , typename A0, ..., typename An-1
+//  BOOST_UPTR_FWD_PARAMS(n)            BOOST_FWD_REF(A0) a0, ..., BOOST_FWD_REF(An-1) an-1
+//  BOOST_UPTR_FWD_TRAILING_PARAMS(n)   , BOOST_FWD_REF(A0) a0, ..., BOOST_FWD_REF(An-1) an-1
+//  BOOST_UPTR_FWD_ARGS(n)              uptr_detail::forward<A0>(a0), ..., uptr_detail::forward<An-1>(an-1)
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_FACTORY_HPP
+#define BOOST_UPTR_FACTORY_HPP
+
+#include <boost/unique_ptr.hpp>
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#define BOOST_UPTR_VARIADIC_FACTORIES
+#else
+#include <boost/preprocessor/arithmetic/inc.hpp>
+#include <boost/preprocessor/repetition/enum.hpp>
+#include <boost/preprocessor/repetition/enum_trailing.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_params.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+
+// maximum number of constructor arguments factories accept without variadic templates
+#if !defined(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY)
+#define BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY 10
+#endif
+
+// limitation of C++03: arguments are taken by const reference (BOOST_FWD_REF),
+// so T can't be constructed from non-const lvalue references.
+// Arguments passed through boost::move are still forwarded as rvalues.
+#define BOOST_UPTR_FWD_PARAM(z, n, data) BOOST_FWD_REF(A##n) a##n
+#define BOOST_UPTR_FWD_ARG(z, n, data) ::boost::uptr_detail::forward<A##n>(a##n)
+
+#define BOOST_UPTR_FWD_TEMPLATE_PARAMS(n) BOOST_PP_ENUM_TRAILING_PARAMS(n, typename A)
+#define BOOST_UPTR_FWD_PARAMS(n) BOOST_PP_ENUM(n, BOOST_UPTR_FWD_PARAM, ~)
+#define BOOST_UPTR_FWD_TRAILING_PARAMS(n) BOOST_PP_ENUM_TRAILING(n, BOOST_UPTR_FWD_PARAM, ~)
+#define BOOST_UPTR_FWD_ARGS(n) BOOST_PP_ENUM(n, BOOST_UPTR_FWD_ARG, ~)
+#endif
+
+#if !defined(BOOST_NO_CXX11_SMART_PTR)
+namespace boost
+{
+    namespace uptr_detail
+    {
+        // unique_ptr.hpp only defines forward() for the emulated unique_ptr
+        using std::forward;
+    }
+}
+#endif
+
+#endif // BOOST_UPTR_FACTORY_HPP
@@ -0,0 +1,33 @@
+//
+// uptr_reject_lvalue.hpp
+//
+// Keeps lvalue owners from being moved from silently by functions which take them by BOOST_RV_REF.
+//
+// Under the C++03 move emulation BOOST_RV_REF(X) is boost::rv<X>&, and a non-const X lvalue converts to it
+// implicitly, so push_back(p) would move from p as if it were push_back(boost::move(p)). Declaring an
+// X& overload marked BOOST_UPTR_REJECT_LVALUE makes such calls fail to compile:
+//
+//  private:
+//      void push_back(value_type&) BOOST_UPTR_REJECT_LVALUE;
+//
+// The overload is deleted where deleted functions are supported, otherwise it is private and never defined.
+// With rvalue references it only gives a clearer error, lvalues don't bind to X&& anyway.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_REJECT_LVALUE_HPP
+#define BOOST_UPTR_REJECT_LVALUE_HPP
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+#define BOOST_UPTR_REJECT_LVALUE
+#else
+#define BOOST_UPTR_REJECT_LVALUE = delete
+#endif
+
+#endif // BOOST_UPTR_REJECT_LVALUE_HPP
@@ -0,0 +1,67 @@
+//
+// uptr_thread.hpp
+//
+// Threads, mutexes, condition variables and clocks for owners which run background work.
+// Maps to the C++11 standard library when available, otherwise to Boost.Thread and Boost.Chrono
+// (which then have to be linked, e.g. -lboost_thread -lboost_chrono).
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_THREAD_HPP
+#define BOOST_UPTR_THREAD_HPP
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD) && !defined(BOOST_NO_CXX11_HDR_MUTEX) \
+    && !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE) && !defined(BOOST_NO_CXX11_HDR_CHRONO)
+#define BOOST_UPTR_STD_THREAD
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#else
+#include <boost/chrono/duration.hpp>
+#include <boost/chrono/system_clocks.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#endif
+
+namespace boost
+{
+    namespace uptr_detail
+    {
+#if defined(BOOST_UPTR_STD_THREAD)
+        using std::thread;
+        using std::mutex;
+        using std::condition_variable;
+        using std::unique_lock;
+        namespace chrono = ::std::chrono;
+        namespace this_thread = ::std::this_thread;
+#else
+        using ::boost::thread;
+        using ::boost::mutex;
+        using ::boost::condition_variable;
+        using ::boost::unique_lock;
+        namespace chrono = ::boost::chrono;
+        namespace this_thread = ::boost::this_thread;
+#endif
+
+        // nanoseconds on a monotonic clock
+        inline int64_t monotonic_ns(void)
+        {
+            return static_cast<int64_t>(chrono::duration_cast<chrono::nanoseconds>(
+                chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    }
+}
+
+#undef BOOST_UPTR_STD_THREAD
+
+#endif // BOOST_UPTR_THREAD_HPP
@@ -0,0 +1,229 @@
+//
+// unique_resource.hpp
+//
+// unique_ptr-like ownership of non-pointer handles which have their own empty value,
+// e.g. file descriptors where -1 means "no descriptor".
+//
+// unique_resource<Handle, Deleter, Invalid> stores the handle by value (no allocation or indirection)
+// and calls Deleter on it unless it equals Invalid. With an empty deleter it is the size of Handle.
+//
+// Ready-made POSIX owners: unique_fd, unique_socket and (on Linux) unique_epoll. They close the descriptor.
+// The distinct deleter types keep the three from being mixed up:
+//
+//  boost::unique_socket s(::socket(AF_INET, SOCK_STREAM, 0));
+//  if(!s) { /* socket failed */ }
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNIQUE_RESOURCE_HPP
+#define BOOST_UNIQUE_RESOURCE_HPP
+
+#include <algorithm>
+#include <boost/config.hpp>
+#include <boost/move/move.hpp>
+#include <boost/relocate.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_reference.hpp>
+#include <boost/unique_ptr/detail/uptr_compressed_pair.hpp>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <unistd.h>
+#endif
+
+namespace boost
+{
+    template<class Handle, class Deleter, Handle Invalid>
+    class unique_resource
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(unique_resource)
+
+        BOOST_STATIC_ASSERT_MSG(!is_reference<Deleter>::value, "unique_resource doesn't support reference deleters.");
+
+    public:
+        typedef Handle handle_type;
+        typedef Deleter deleter_type;
+
+        BOOST_STATIC_CONSTANT(Handle, invalid = Invalid);
+
+        unique_resource(void) :
+            storage(Invalid)
+        {
+        }
+
+        explicit unique_resource(Handle h) :
+            storage(h)
+        {
+        }
+
+        unique_resource(Handle h, const Deleter& d) :
+            storage(h, d)
+        {
+        }
+
+        unique_resource(BOOST_RV_REF(unique_resource) r) :
+            storage(r.release(), boost::move(r.get_deleter()))
+        {
+        }
+
+        ~unique_resource(void)
+        {
+            reset();
+        }
+
+        unique_resource& operator=(BOOST_RV_REF(unique_resource) r)
+        {
+            reset(r.release());
+            storage.second() = boost::move(r.get_deleter());
+            return *this;
+        }
+
+        Handle get(void) const
+        {
+            return storage.first();
+        }
+
+        Deleter& get_deleter(void)
+        {
+            return storage.second();
+        }
+
+        const Deleter& get_deleter(void) const
+        {
+            return storage.second();
+        }
+
+        /**
+         * Gives up ownership, leaving this empty. Returns the handle.
+         */
+        Handle release(void)
+        {
+            const Handle h = storage.first();
+            storage.first() = Invalid;
+            return h;
+        }
+
+        /**
+         * Takes ownership of h and frees the previously owned handle.
+         */
+        void reset(Handle h = Invalid)
+        {
+            const Handle old = storage.first();
+            storage.first() = h;
+            if(old != Invalid)
+            {
+                storage.second()(old);
+            }
+        }
+
+        void swap(unique_resource& r)
+        {
+            using std::swap;
+            swap(storage.first(), r.storage.first());
+            swap(storage.second(), r.storage.second());
+        }
+
+#if defined(BOOST_NO_CXX11_EXPLICIT_CONVERSION_OPERATORS)
+        // safe bool idiom
+    private:
+        typedef void (*bool_type)();
+        static void this_type_does_not_support_comparisons()
+        {
+        }
+    public:
+        operator bool_type(void) const
+        {
+            return storage.first() != Invalid ? &this_type_does_not_support_comparisons : 0;
+        }
+#else
+        explicit operator bool(void) const
+        {
+            return storage.first() != Invalid;
+        }
+#endif
+
+    private:
+        ::boost::uptr_detail::compressed_pair<Handle, Deleter> storage;
+    };
+
+    template<class Handle, class Deleter, Handle Invalid>
+    inline void swap(unique_resource<Handle, Deleter, Invalid>& a, unique_resource<Handle, Deleter, Invalid>& b)
+    {
+        a.swap(b);
+    }
+
+    template<class Handle, class Deleter, Handle Invalid>
+    inline bool operator==(const unique_resource<Handle, Deleter, Invalid>& a,
+        const unique_resource<Handle, Deleter, Invalid>& b)
+    {
+        return a.get() == b.get();
+    }
+
+    template<class Handle, class Deleter, Handle Invalid>
+    inline bool operator!=(const unique_resource<Handle, Deleter, Invalid>& a,
+        const unique_resource<Handle, Deleter, Invalid>& b)
+    {
+        return a.get() != b.get();
+    }
+
+    template<class Handle, class Deleter, Handle Invalid>
+    inline bool operator<(const unique_resource<Handle, Deleter, Invalid>& a,
+        const unique_resource<Handle, Deleter, Invalid>& b)
+    {
+        return a.get() < b.get();
+    }
+
+    // the handle is stored by value, so the owner can be moved bitwise if its deleter can
+    template<class Handle, class Deleter, Handle Invalid>
+    struct is_trivially_relocatable<unique_resource<Handle, Deleter, Invalid> > :
+        is_trivially_relocatable<Deleter>
+    {
+    };
+
+#if defined(BOOST_HAS_UNISTD_H)
+    /**
+     * Equivalent to: ::close(fd);
+     */
+    struct close_fd
+    {
+        void operator()(int fd) const
+        {
+            ::close(fd);
+        }
+    };
+
+    /**
+     * Equivalent to: ::close(fd);
+     */
+    struct close_socket
+    {
+        void operator()(int fd) const
+        {
+            ::close(fd);
+        }
+    };
+
+    typedef unique_resource<int, close_fd, -1> unique_fd;
+    typedef unique_resource<int, close_socket, -1> unique_socket;
+
+#if defined(__linux__)
+    /**
+     * Equivalent to: ::close(fd);
+     */
+    struct close_epoll
+    {
+        void operator()(int fd) const
+        {
+            ::close(fd);
+        }
+    };
+
+    typedef unique_resource<int, close_epoll, -1> unique_epoll;
+#endif
+#endif
+}
+
+#endif // BOOST_UNIQUE_RESOURCE_HPP
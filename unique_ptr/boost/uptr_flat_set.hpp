@@ -0,0 +1,398 @@
+//
+// uptr_flat_set.hpp
+//
+// Hash set owning its elements, looked up by raw pointer.
+//
+// uptr_flat_set<T, D> stores the owned pointers in one open-addressing table (linear probing, power of 2
+// capacity, at most 3/4 full), so a lookup hashes the pointer and scans adjacent slots of a single array.
+// Like the channels, only raw pointers are stored and the deleter is kept once per set (compressed away when
+// empty), so per-object deleter state isn't kept. Lookup and erase take a plain T*, no owner is built:
+//
+//  boost::uptr_flat_set<session> sessions;
+//  session* s = sessions.insert(boost::make_unique<session>(id));
+//  if(sessions.contains(s)) ...
+//  sessions.erase(s);                             // deletes the session
+//  boost::unique_ptr<session> p = sessions.extract(s);  // or takes it back out
+//
+// Erasing shifts the following entries of the probe sequence back, there are no tombstones.
+// Inserting may rehash, which moves pointers between slots but never the objects, so pointers to elements
+// stay valid until they are erased. Iterators yield the raw pointers and are invalidated by insert and erase.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_FLAT_SET_HPP
+#define BOOST_UPTR_FLAT_SET_HPP
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_array.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/unique_ptr.hpp>
+#include <boost/unique_ptr/detail/uptr_compressed_pair.hpp>
+#include <boost/unique_ptr/detail/uptr_reject_lvalue.hpp>
+
+namespace boost
+{
+    template<class T, class D = default_delete<T> >
+    class uptr_flat_set
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(uptr_flat_set)
+
+        BOOST_STATIC_ASSERT_MSG(!is_array<T>::value, "uptr_flat_set doesn't support arrays.");
+        BOOST_STATIC_ASSERT_MSG((is_same<typename unique_ptr<T, D>::pointer, T*>::value),
+            "uptr_flat_set needs a deleter taking T*.");
+
+    public:
+        typedef unique_ptr<T, D> value_type;
+        typedef T* pointer;
+        typedef D deleter_type;
+        typedef std::size_t size_type;
+
+        /**
+         * Forward iterator over the owned pointers, in table order.
+         */
+        class const_iterator
+        {
+        public:
+            const_iterator(void) :
+                slot(), end()
+            {
+            }
+
+            pointer operator*(void) const
+            {
+                return *slot;
+            }
+
+            const_iterator& operator++(void)
+            {
+                ++slot;
+                skip();
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator tmp(*this);
+                ++*this;
+                return tmp;
+            }
+
+            friend bool operator==(const const_iterator& a, const const_iterator& b)
+            {
+                return a.slot == b.slot;
+            }
+
+            friend bool operator!=(const const_iterator& a, const const_iterator& b)
+            {
+                return a.slot != b.slot;
+            }
+
+        private:
+            friend class uptr_flat_set;
+
+            const_iterator(const pointer* slot, const pointer* end) :
+                slot(slot), end(end)
+            {
+                skip();
+            }
+
+            void skip(void)
+            {
+                while(slot != end && *slot == 0)
+                {
+                    ++slot;
+                }
+            }
+
+            const pointer* slot;
+            const pointer* end;
+        };
+
+        typedef const_iterator iterator;
+
+        explicit uptr_flat_set(const D& d = D()) :
+            storage(0, d), cap(), count(), shift(bits)
+        {
+        }
+
+        uptr_flat_set(BOOST_RV_REF(uptr_flat_set) s) :
+            storage(s.storage.first(), boost::move(s.get_deleter())), cap(s.cap), count(s.count), shift(s.shift)
+        {
+            s.storage.first() = 0;
+            s.cap = s.count = 0;
+            s.shift = bits;
+        }
+
+        ~uptr_flat_set(void)
+        {
+            destroy_all();
+            delete[] storage.first();
+        }
+
+        uptr_flat_set& operator=(BOOST_RV_REF(uptr_flat_set) s)
+        {
+            uptr_flat_set(boost::move(s)).swap(*this);
+            return *this;
+        }
+
+        D& get_deleter(void)
+        {
+            return storage.second();
+        }
+
+        const D& get_deleter(void) const
+        {
+            return storage.second();
+        }
+
+        const_iterator begin(void) const
+        {
+            return const_iterator(storage.first(), storage.first() + cap);
+        }
+
+        const_iterator end(void) const
+        {
+            return const_iterator(storage.first() + cap, storage.first() + cap);
+        }
+
+        size_type size(void) const
+        {
+            return count;
+        }
+
+        bool empty(void) const
+        {
+            return count == 0;
+        }
+
+        /**
+         * Number of slots in the table.
+         */
+        size_type capacity(void) const
+        {
+            return cap;
+        }
+
+        /**
+         * Takes ownership of p's object and returns its pointer. Null pointers aren't inserted (returns null).
+         * p's deleter isn't kept, the object will be deleted with get_deleter().
+         */
+        pointer insert(BOOST_RV_REF(value_type) p)
+        {
+            const pointer raw = p.get();
+            if(raw != 0)
+            {
+                if((count + 1) * 4 > cap * 3)
+                {
+                    rehash(cap != 0 ? 2 * cap : size_type(min_capacity));
+                }
+                place(raw);
+                p.release();
+                ++count;
+            }
+            return raw;
+        }
+
+        /**
+         * true if p is owned by this set
+         */
+        bool contains(const T* p) const
+        {
+            return p != 0 && find_slot(p) != 0;
+        }
+
+        /**
+         * Deletes the element p. Returns false if p isn't owned by this set.
+         */
+        bool erase(const T* p)
+        {
+            const pointer owned = remove(p);
+            if(owned != 0)
+            {
+                storage.second()(owned);
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Removes p from the set without deleting it and returns its owner, or a null owner if p isn't in the set.
+         */
+        value_type extract(const T* p)
+        {
+            return value_type(remove(p), storage.second());
+        }
+
+        /**
+         * Deletes all elements, keeping the table.
+         */
+        void clear(void)
+        {
+            destroy_all();
+            for(size_type i = 0; i < cap; ++i)
+            {
+                storage.first()[i] = 0;
+            }
+            count = 0;
+        }
+
+        /**
+         * Grows the table so n elements fit without rehashing.
+         */
+        void reserve(size_type n)
+        {
+            size_type c = cap != 0 ? cap : size_type(min_capacity);
+            while(n * 4 > c * 3)
+            {
+                c *= 2;
+                if(c == 0)
+                {
+                    throw std::length_error("uptr_flat_set");
+                }
+            }
+            if(c != cap)
+            {
+                rehash(c);
+            }
+        }
+
+        void swap(uptr_flat_set& s)
+        {
+            using std::swap;
+            swap(storage.first(), s.storage.first());
+            swap(storage.second(), s.storage.second());
+            swap(cap, s.cap);
+            swap(count, s.count);
+            swap(shift, s.shift);
+        }
+
+    private:
+        pointer insert(value_type&) BOOST_UPTR_REJECT_LVALUE;
+
+        BOOST_STATIC_CONSTANT(size_type, min_capacity = 8);
+        BOOST_STATIC_CONSTANT(unsigned, bits = 64);
+
+        // Fibonacci hashing: the top bits of the product depend on all bits of the address,
+        // including the ones above the alignment zeros
+        size_type home(const T* p) const
+        {
+            return static_cast<size_type>((static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p))
+                * UINT64_C(0x9E3779B97F4A7C15)) >> shift);
+        }
+
+        pointer* find_slot(const T* p) const
+        {
+            if(cap == 0)
+            {
+                return 0;
+            }
+            const size_type mask = cap - 1;
+            for(size_type i = home(p);; i = (i + 1) & mask)
+            {
+                pointer* slot = storage.first() + i;
+                if(*slot == p)
+                {
+                    return slot;
+                }
+                if(*slot == 0)
+                {
+                    return 0;
+                }
+            }
+        }
+
+        // p isn't in the table and there is a free slot
+        void place(pointer p)
+        {
+            const size_type mask = cap - 1;
+            size_type i = home(p);
+            while(storage.first()[i] != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            storage.first()[i] = p;
+        }
+
+        // takes p out of the table, returns null if it isn't there
+        pointer remove(const T* p)
+        {
+            pointer* slot = p != 0 ? find_slot(p) : 0;
+            if(slot == 0)
+            {
+                return 0;
+            }
+            const pointer owned = *slot;
+            // backward shift: move later entries of the probe sequence into the hole unless that would put them
+            // before their home slot
+            const size_type mask = cap - 1;
+            size_type hole = static_cast<size_type>(slot - storage.first());
+            for(size_type i = (hole + 1) & mask; storage.first()[i] != 0; i = (i + 1) & mask)
+            {
+                const size_type h = home(storage.first()[i]);
+                if(((i - h) & mask) >= ((i - hole) & mask))
+                {
+                    storage.first()[hole] = storage.first()[i];
+                    hole = i;
+                }
+            }
+            storage.first()[hole] = 0;
+            --count;
+            return owned;
+        }
+
+        void rehash(size_type new_cap)
+        {
+            pointer* const old = storage.first();
+            const size_type old_cap = cap;
+            storage.first() = new pointer[new_cap]();
+            cap = new_cap;
+            shift = bits;
+            for(size_type c = new_cap; c > 1; c /= 2)
+            {
+                --shift;
+            }
+            for(size_type i = 0; i < old_cap; ++i)
+            {
+                if(old[i] != 0)
+                {
+                    place(old[i]);
+                }
+            }
+            delete[] old;
+        }
+
+        void destroy_all(void)
+        {
+            for(size_type i = 0; i < cap; ++i)
+            {
+                if(storage.first()[i] != 0)
+                {
+                    storage.second()(storage.first()[i]);
+                }
+            }
+        }
+
+        ::boost::uptr_detail::compressed_pair<pointer*, D> storage;
+        size_type cap;
+        size_type count;
+        // 64 - log2(cap), the hash keeps the top log2(cap) bits of the product
+        unsigned shift;
+    };
+
+    template<class T, class D>
+    inline void swap(uptr_flat_set<T, D>& a, uptr_flat_set<T, D>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif // BOOST_UPTR_FLAT_SET_HPP
@@ -0,0 +1,381 @@
+//
+// uptr_vector.hpp
+//
+// Contiguous, move-aware sequence of unique_ptr<T, D> which works with C++03 move emulation.
+//
+// Elements are moved in and out with boost::move. Growth, insert and erase relocate elements
+// (see relocate.hpp), so buffers of unique_ptrs with trivially relocatable deleters are moved with
+// a single memcpy/memmove instead of element by element.
+//
+// Relocating elements which aren't trivially relocatable requires a non-throwing move constructor
+// of the deleter.
+//
+// (c) 2013 Andrew Ho
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UPTR_VECTOR_HPP
+#define BOOST_UPTR_VECTOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <boost/relocate.hpp>
+#include <boost/unique_ptr/detail/uptr_factory.hpp>
+#include <boost/unique_ptr/detail/uptr_reject_lvalue.hpp>
+
+#if !defined(BOOST_UPTR_VARIADIC_FACTORIES)
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/preprocessor/repetition/repeat_from_to.hpp>
+#endif
+
+namespace boost
+{
+    template<class T, class D = default_delete<T> >
+    class uptr_vector
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(uptr_vector)
+
+    public:
+        typedef unique_ptr<T, D> value_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef value_type* iterator;
+        typedef const value_type* const_iterator;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        uptr_vector(void) :
+            first(), last(), cap()
+        {
+        }
+
+        uptr_vector(BOOST_RV_REF(uptr_vector) v) :
+            first(v.first), last(v.last), cap(v.cap)
+        {
+            v.first = v.last = v.cap = 0;
+        }
+
+        ~uptr_vector(void)
+        {
+            destroy_all();
+            ::operator delete(first);
+        }
+
+        uptr_vector& operator=(BOOST_RV_REF(uptr_vector) v)
+        {
+            uptr_vector(boost::move(v)).swap(*this);
+            return *this;
+        }
+
+        iterator begin(void)
+        {
+            return first;
+        }
+
+        const_iterator begin(void) const
+        {
+            return first;
+        }
+
+        iterator end(void)
+        {
+            return last;
+        }
+
+        const_iterator end(void) const
+        {
+            return last;
+        }
+
+        value_type* data(void)
+        {
+            return first;
+        }
+
+        const value_type* data(void) const
+        {
+            return first;
+        }
+
+        size_type size(void) const
+        {
+            return static_cast<size_type>(last - first);
+        }
+
+        size_type capacity(void) const
+        {
+            return static_cast<size_type>(cap - first);
+        }
+
+        bool empty(void) const
+        {
+            return first == last;
+        }
+
+        size_type max_size(void) const
+        {
+            return static_cast<size_type>(-1) / sizeof(value_type);
+        }
+
+        reference operator[](size_type i)
+        {
+            return first[i];
+        }
+
+        const_reference operator[](size_type i) const
+        {
+            return first[i];
+        }
+
+        reference at(size_type i)
+        {
+            check_index(i);
+            return first[i];
+        }
+
+        const_reference at(size_type i) const
+        {
+            check_index(i);
+            return first[i];
+        }
+
+        reference front(void)
+        {
+            return *first;
+        }
+
+        const_reference front(void) const
+        {
+            return *first;
+        }
+
+        reference back(void)
+        {
+            return last[-1];
+        }
+
+        const_reference back(void) const
+        {
+            return last[-1];
+        }
+
+        /**
+         * Grows the buffer to hold at least n elements by relocating the existing elements.
+         */
+        void reserve(size_type n)
+        {
+            if(n > capacity())
+            {
+                value_type* buf = allocate(n);
+                ::boost::uninitialized_relocate(first, last, buf);
+                adopt(buf, size(), n);
+            }
+        }
+
+        /**
+         * Takes ownership of p's object. p may be an element of this vector.
+         */
+        void push_back(BOOST_RV_REF(value_type) p)
+        {
+            if(last != cap)
+            {
+                ::new (static_cast<void*>(last)) value_type(boost::move(p));
+                ++last;
+            }
+            else
+            {
+                // the new element is moved in before the old buffer goes away, in case p lives in it
+                const size_type n = size();
+                const size_type new_cap = grown_capacity(n + 1);
+                value_type* buf = allocate(new_cap);
+                ::new (static_cast<void*>(buf + n)) value_type(boost::move(p));
+                ::boost::uninitialized_relocate(first, last, buf);
+                adopt(buf, n + 1, new_cap);
+            }
+        }
+
+#if defined(BOOST_UPTR_VARIADIC_FACTORIES)
+        /**
+         * Equivalent to: push_back(value_type(new T(std::forward<Args>(args)...)));
+         */
+        template<typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            value_type p(new T(::boost::uptr_detail::forward<Args>(args)...));
+            push_back(boost::move(p));
+        }
+#else
+        /**
+         * Equivalent to: push_back(value_type(new T));
+         */
+        void emplace_back(void)
+        {
+            value_type p(new T());
+            push_back(boost::move(p));
+        }
+
+        /**
+         * Equivalent to: push_back(value_type(new T(a0, ..., an-1)));
+         */
+#define BOOST_UPTR_VECTOR_EMPLACE_BACK(z, n, data) \
+        template<BOOST_PP_ENUM_PARAMS(n, typename A)> \
+        void emplace_back(BOOST_UPTR_FWD_PARAMS(n)) \
+        { \
+            value_type p(new T(BOOST_UPTR_FWD_ARGS(n))); \
+            push_back(boost::move(p)); \
+        }
+
+        BOOST_PP_REPEAT_FROM_TO(1, BOOST_PP_INC(BOOST_UPTR_MAKE_UNIQUE_MAX_ARITY), BOOST_UPTR_VECTOR_EMPLACE_BACK, ~)
+
+#undef BOOST_UPTR_VECTOR_EMPLACE_BACK
+#endif
+
+        /**
+         * Destroys the last element.
+         */
+        void pop_back(void)
+        {
+            --last;
+            last->~value_type();
+        }
+
+        /**
+         * Inserts p before pos, relocating the elements after it. p may be an element of this vector.
+         * Returns an iterator to the inserted element.
+         */
+        iterator insert(const_iterator pos, BOOST_RV_REF(value_type) p)
+        {
+            const size_type i = static_cast<size_type>(pos - first);
+            if(last != cap)
+            {
+                value_type tmp(boost::move(p));
+                ::boost::relocate_n(first + i, size() - i, first + i + 1);
+                ::new (static_cast<void*>(first + i)) value_type(boost::move(tmp));
+                ++last;
+            }
+            else
+            {
+                const size_type n = size();
+                const size_type new_cap = grown_capacity(n + 1);
+                value_type* buf = allocate(new_cap);
+                ::new (static_cast<void*>(buf + i)) value_type(boost::move(p));
+                ::boost::uninitialized_relocate(first, first + i, buf);
+                ::boost::uninitialized_relocate(first + i, last, buf + i + 1);
+                adopt(buf, n + 1, new_cap);
+            }
+            return first + i;
+        }
+
+        /**
+         * Destroys the element at pos and relocates the elements after it.
+         * Returns an iterator to the element after the erased one.
+         */
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        /**
+         * Destroys [from, to) and relocates the elements after it.
+         * Returns an iterator to the element after the erased ones.
+         */
+        iterator erase(const_iterator from, const_iterator to)
+        {
+            value_type* const b = first + (from - first);
+            value_type* const e = first + (to - first);
+            for(value_type* p = b; p != e; ++p)
+            {
+                p->~value_type();
+            }
+            ::boost::relocate_n(e, static_cast<size_type>(last - e), b);
+            last -= e - b;
+            return b;
+        }
+
+        /**
+         * Destroys all elements, keeping the buffer.
+         */
+        void clear(void)
+        {
+            destroy_all();
+            last = first;
+        }
+
+        void swap(uptr_vector& v)
+        {
+            value_type* tmp = first;
+            first = v.first;
+            v.first = tmp;
+            tmp = last;
+            last = v.last;
+            v.last = tmp;
+            tmp = cap;
+            cap = v.cap;
+            v.cap = tmp;
+        }
+
+    private:
+        void push_back(value_type&) BOOST_UPTR_REJECT_LVALUE;
+        iterator insert(const_iterator, value_type&) BOOST_UPTR_REJECT_LVALUE;
+
+        void check_index(size_type i) const
+        {
+            if(i >= size())
+            {
+                throw std::out_of_range("uptr_vector::at");
+            }
+        }
+
+        size_type grown_capacity(size_type needed) const
+        {
+            if(needed > max_size())
+            {
+                throw std::length_error("uptr_vector");
+            }
+            const size_type c = capacity();
+            const size_type doubled = c > max_size() / 2 ? max_size() : 2 * c;
+            return doubled < needed ? needed : doubled;
+        }
+
+        value_type* allocate(size_type n) const
+        {
+            if(n > max_size())
+            {
+                throw std::length_error("uptr_vector");
+            }
+            return static_cast<value_type*>(::operator new(n * sizeof(value_type)));
+        }
+
+        // takes over buf after the elements have been relocated into it
+        void adopt(value_type* buf, size_type n, size_type new_cap)
+        {
+            ::operator delete(first);
+            first = buf;
+            last = buf + n;
+            cap = buf + new_cap;
+        }
+
+        void destroy_all(void)
+        {
+            for(value_type* p = first; p != last; ++p)
+            {
+                p->~value_type();
+            }
+        }
+
+        value_type* first;
+        value_type* last;
+        value_type* cap;
+    };
+
+    template<class T, class D>
+    inline void swap(uptr_vector<T, D>& a, uptr_vector<T, D>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif // BOOST_UPTR_VECTOR_HPP